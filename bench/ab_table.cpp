@@ -0,0 +1,89 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+
+using namespace std;
+
+// Joins the CSV output of bench/compare.cpp for two backends into one
+// side-by-side table keyed on (operation, degree).
+//
+// Usage: ab_table A.csv B.csv
+
+struct Row
+{
+    string backend;
+    double medianNs = 0;
+    string allocations;
+    string error;
+};
+
+static bool readCsv(const string &path, map<pair<string, int>, Row> &rows, vector<pair<string, int>> &order, string &backend)
+{
+    ifstream in(path);
+    if (!in)
+        return false;
+
+    string line;
+    getline(in, line); // Header
+    while (getline(in, line))
+    {
+        stringstream fields(line);
+        string operation, degree, median;
+        Row row;
+        getline(fields, row.backend, ',');
+        getline(fields, operation, ',');
+        getline(fields, degree, ',');
+        getline(fields, median, ',');
+        getline(fields, row.allocations, ',');
+        getline(fields, row.error, ',');
+        row.medianNs = stod(median);
+        backend = row.backend;
+
+        pair<string, int> key(operation, stoi(degree));
+        if (!rows.count(key))
+            order.push_back(key);
+        rows[key] = row;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        cerr << "Usage: ab_table A.csv B.csv" << endl;
+        return 1;
+    }
+
+    map<pair<string, int>, Row> a, b;
+    vector<pair<string, int>> order, unused;
+    string nameA, nameB;
+    if (!readCsv(argv[1], a, order, nameA) || !readCsv(argv[2], b, unused, nameB))
+    {
+        cerr << "Cannot read input files." << endl;
+        return 1;
+    }
+
+    cout << left << setw(12) << "operation" << right << setw(8) << "degree"
+         << setw(14) << (nameA + " ns") << setw(14) << (nameB + " ns") << setw(8) << "B/A"
+         << setw(10) << "allocs A" << setw(10) << "allocs B"
+         << setw(13) << "error A" << setw(13) << "error B" << endl;
+
+    for (const auto &key : order)
+    {
+        if (!b.count(key))
+            continue;
+        const Row &ra = a[key];
+        const Row &rb = b[key];
+        cout << left << setw(12) << key.first << right << setw(8) << key.second
+             << setw(14) << fixed << setprecision(0) << ra.medianNs << setw(14) << rb.medianNs
+             << setw(8) << setprecision(2) << (ra.medianNs > 0 ? rb.medianNs / ra.medianNs : 0)
+             << setw(10) << ra.allocations << setw(10) << rb.allocations
+             << setw(13) << ra.error << setw(13) << rb.error << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,332 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include "../polynomial.h"
+#include "../polynomial_dispatch.h"
+#include "bench_util.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Micro-benchmark driver for the Polynomial operations.
+// Sweeps degree and batch size, runs warmup iterations, then times each
+// repetition separately and reports median / p99 per call. Results go to
+// stdout (or --out) as CSV or JSON so two builds can be diffed.
+//
+// Usage: bench [--max-degree N] [--batch 1,64] [--reps N] [--warmup N]
+//              [--format csv|json] [--out FILE] [--only OPERATION]
+
+#ifndef POLY_BACKEND
+#define POLY_BACKEND "unknown"
+#endif
+
+struct Options
+{
+    int maxDegree = 1000000;
+    vector<int> batches = {1, 64};
+    int reps = 30;
+    int warmup = 3;
+    string format = "csv";
+    string out;
+    string only;
+};
+
+struct Result
+{
+    string operation;
+    int degree;
+    int batch;
+    int reps;
+    double medianNs;
+    double p99Ns;
+    double minNs;
+    double meanNs;
+};
+
+struct Operation
+{
+    string name;
+    int maxDegree; // Larger degrees are skipped (quadratic or worse cost)
+    // Builds the work for one degree and batch size; the returned function
+    // runs the whole batch once
+    function<function<void()>(int degree, int batch)> prepare;
+};
+
+static vector<Operation> operations()
+{
+    vector<Operation> ops;
+
+    ops.push_back({"multiply", 10000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto q = make_shared<Polynomial>(randomCoefficients(degree, 2));
+                       return function<void()>([=]()
+                                               {
+                           for (int i = 0; i < batch; ++i)
+                           {
+                               Polynomial r = *p * *q;
+                               doNotOptimize(r);
+                           } });
+                   }});
+
+    ops.push_back({"evaluate", 1000000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto xs = make_shared<vector<double>>(randomPoints(batch, 3));
+                       return function<void()>([=]()
+                                               {
+                           for (double x : *xs)
+                           {
+                               double y = p->evaluate(x);
+                               doNotOptimize(y);
+                           } });
+                   }});
+
+    // Paterson-Stockmeyer plan against the plain Horner rows above: same
+    // points, one call per point and one batched call
+    ops.push_back({"evaluate_plan", 1000000, [](int degree, int batch)
+                   {
+                       auto plan = make_shared<Polynomial::Plan>(Polynomial(randomCoefficients(degree, 1)).plan());
+                       auto xs = make_shared<vector<double>>(randomPoints(batch, 3));
+                       return function<void()>([=]()
+                                               {
+                           for (double x : *xs)
+                           {
+                               double y = plan->evaluate(x);
+                               doNotOptimize(y);
+                           } });
+                   }});
+
+    ops.push_back({"evaluate_plan_batch", 1000000, [](int degree, int batch)
+                   {
+                       auto plan = make_shared<Polynomial::Plan>(Polynomial(randomCoefficients(degree, 1)).plan());
+                       auto xs = make_shared<vector<double>>(randomPoints(batch, 3));
+                       auto ys = make_shared<vector<double>>(batch);
+                       return function<void()>([=]()
+                                               {
+                           plan->evaluate(xs->data(), ys->data(), xs->size());
+                           doNotOptimize(*ys); });
+                   }});
+
+    ops.push_back({"evaluate_accurate", 1000000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto xs = make_shared<vector<double>>(randomPoints(batch, 3));
+                       return function<void()>([=]()
+                                               {
+                           for (double x : *xs)
+                           {
+                               double y = p->evaluateAccurate(x);
+                               doNotOptimize(y);
+                           } });
+                   }});
+
+    ops.push_back({"compose", 1000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto q = make_shared<Polynomial>(vector<double>{0.5, 1.0, 0.25});
+                       return function<void()>([=]()
+                                               {
+                           for (int i = 0; i < batch; ++i)
+                           {
+                               Polynomial r = p->compose(*q);
+                               doNotOptimize(r);
+                           } });
+                   }});
+
+    ops.push_back({"derivative", 1000000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       return function<void()>([=]()
+                                               {
+                           for (int i = 0; i < batch; ++i)
+                           {
+                               Polynomial r = p->derivative();
+                               doNotOptimize(r);
+                           } });
+                   }});
+
+    ops.push_back({"integral", 1000000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto xs = make_shared<vector<double>>(randomPoints(batch + 1, 4));
+                       return function<void()>([=]()
+                                               {
+                           for (int i = 0; i < batch; ++i)
+                           {
+                               double y = p->integral((*xs)[i], (*xs)[i + 1]);
+                               doNotOptimize(y);
+                           } });
+                   }});
+
+    ops.push_back({"getRoot", 100000, [](int degree, int batch)
+                   {
+                       auto p = make_shared<Polynomial>(randomCoefficients(degree, 1));
+                       auto xs = make_shared<vector<double>>(randomPoints(batch, 5));
+                       return function<void()>([=]()
+                                               {
+                           for (double guess : *xs)
+                           {
+                               try
+                               {
+                                   double root = p->getRoot(guess);
+                                   doNotOptimize(root);
+                               }
+                               catch (const runtime_error &)
+                               {
+                                   // Non-convergence still costs maxIter iterations
+                               }
+                           } });
+                   }});
+
+    return ops;
+}
+
+static Result run(const string &name, int degree, int batch, const function<void()> &work, const Options &options)
+{
+    // The first warmup run also sizes the repetition count so that slow cases
+    // (high degree multiply or compose) stay within about a second
+    auto warmStart = steady_clock::now();
+    work();
+    double firstRun = duration<double>(steady_clock::now() - warmStart).count();
+    for (int i = 1; i < options.warmup && firstRun < 0.1; ++i)
+        work();
+
+    int reps = options.reps;
+    if (firstRun * reps > 1.0)
+        reps = max(3, static_cast<int>(1.0 / firstRun));
+    reps = min(reps, options.reps);
+
+    vector<double> samples(reps);
+    for (int i = 0; i < reps; ++i)
+    {
+        auto start = steady_clock::now();
+        work();
+        auto stop = steady_clock::now();
+        samples[i] = duration<double, nano>(stop - start).count() / batch;
+    }
+
+    Result result{name, degree, batch, reps, 0, 0, 0, 0};
+    sort(samples.begin(), samples.end());
+    result.medianNs = percentile(samples, 0.5);
+    result.p99Ns = percentile(samples, 0.99);
+    result.minNs = samples.front();
+    for (double s : samples)
+        result.meanNs += s / samples.size();
+    return result;
+}
+
+static void writeCsv(ostream &out, const vector<Result> &results)
+{
+    out << "backend,operation,degree,batch,reps,median_ns,p99_ns,min_ns,mean_ns\n";
+    for (const Result &r : results)
+    {
+        out << POLY_BACKEND << "," << r.operation << "," << r.degree << "," << r.batch << "," << r.reps << ","
+            << r.medianNs << "," << r.p99Ns << "," << r.minNs << "," << r.meanNs << "\n";
+    }
+}
+
+static void writeJson(ostream &out, const vector<Result> &results)
+{
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        out << "  {\"backend\": \"" << POLY_BACKEND << "\", \"operation\": \"" << r.operation
+            << "\", \"degree\": " << r.degree << ", \"batch\": " << r.batch << ", \"reps\": " << r.reps
+            << ", \"median_ns\": " << r.medianNs << ", \"p99_ns\": " << r.p99Ns
+            << ", \"min_ns\": " << r.minNs << ", \"mean_ns\": " << r.meanNs << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+static vector<int> parseList(const string &text)
+{
+    vector<int> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ','))
+        values.push_back(stoi(item));
+    return values;
+}
+
+static Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+            throw invalid_argument("Missing value for " + arg);
+        string value = argv[++i];
+        if (arg == "--max-degree")
+            options.maxDegree = stoi(value);
+        else if (arg == "--batch")
+            options.batches = parseList(value);
+        else if (arg == "--reps")
+            options.reps = max(1, stoi(value));
+        else if (arg == "--warmup")
+            options.warmup = stoi(value);
+        else if (arg == "--format")
+            options.format = value;
+        else if (arg == "--out")
+            options.out = value;
+        else if (arg == "--only")
+            options.only = value;
+        else
+            throw invalid_argument("Unknown option " + arg);
+    }
+    return options;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    // POLYNOMIAL_ISA forces a kernel variant; say which one is measured
+    cerr << "kernels: " << polydispatch::name(polydispatch::isa()) << endl;
+
+    vector<Result> results;
+    for (const Operation &op : operations())
+    {
+        if (!options.only.empty() && options.only != op.name)
+            continue;
+        for (int degree = 1; degree <= min(options.maxDegree, op.maxDegree); degree *= 10)
+        {
+            for (int batch : options.batches)
+            {
+                function<void()> work = op.prepare(degree, batch);
+                results.push_back(run(op.name, degree, batch, work, options));
+                cerr << op.name << " degree " << degree << " batch " << batch
+                     << ": median " << results.back().medianNs << " ns" << endl;
+            }
+        }
+    }
+
+    ofstream file;
+    if (!options.out.empty())
+        file.open(options.out);
+    ostream &out = options.out.empty() ? cout : file;
+    if (options.format == "json")
+        writeJson(out, results);
+    else
+        writeCsv(out, results);
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Keep the compiler from discarding a result that is otherwise unused
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// fraction in [0, 1] of an ascending sample vector
+inline double percentile(const std::vector<double> &sorted, double fraction)
+{
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+inline std::vector<double> randomCoefficients(int degree, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> coeffs(degree + 1);
+    for (double &c : coeffs)
+        c = dist(rng);
+    if (coeffs.back() == 0)
+        coeffs.back() = 1.0;
+    return coeffs;
+}
+
+inline std::vector<double> randomPoints(int count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> xs(count);
+    for (double &x : xs)
+        x = dist(rng);
+    return xs;
+}
+
+#endif // BENCH_UTIL_H
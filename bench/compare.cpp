@@ -0,0 +1,264 @@
+#include <iostream>
+#include <atomic>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <new>
+#include <cstdlib>
+#include <stdexcept>
+#include "../polynomial.h"
+#include "bench_util.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Correctness and cost driver linked once per backend.
+// For each operation and degree it records median latency, heap allocations
+// per call and the largest relative deviation from a long double reference
+// computed here, independent of the backend. bench/ab_table.cpp joins the
+// CSV of two backends into a side-by-side table.
+//
+// Usage: compare [--out FILE] [--reps N]
+
+#ifndef POLY_BACKEND
+#define POLY_BACKEND "unknown"
+#endif
+
+// Allocation counting through the global allocation functions. Atomic
+// because multiply and compose also allocate on task pool threads.
+static atomic<size_t> allocationCount{0};
+
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+static long double referenceEvaluate(const vector<double> &coeffs, long double x)
+{
+    long double result = 0;
+    for (int i = static_cast<int>(coeffs.size()) - 1; i >= 0; --i)
+        result = result * x + coeffs[i];
+    return result;
+}
+
+// Coefficients as seen through the public interface of the backend
+static vector<double> coefficientsOf(const Polynomial &p)
+{
+    vector<double> coeffs;
+    for (int k = 0; k <= p.degree(); ++k)
+        coeffs.push_back(p.getCoefficient(k));
+    return coeffs;
+}
+
+static double relativeError(long double actual, long double expected)
+{
+    return static_cast<double>(fabsl(actual - expected) / max(1.0L, fabsl(expected)));
+}
+
+struct Case
+{
+    string operation;
+    int maxDegree;
+    // One call of the backend operation; this is what is timed and counted
+    function<void(Polynomial &p, const Polynomial &q, double x1, double x2)> call;
+    // Largest deviation of the backend result from the reference over xs
+    function<double(Polynomial &p, const Polynomial &q, const vector<double> &xs)> deviation;
+};
+
+static vector<Case> cases()
+{
+    vector<Case> list;
+
+    list.push_back({"multiply", 1000,
+                    [](Polynomial &p, const Polynomial &q, double, double)
+                    {
+                        Polynomial r = p * q;
+                        doNotOptimize(r);
+                    },
+                    [](Polynomial &p, const Polynomial &q, const vector<double> &xs)
+                    {
+                        vector<double> r = coefficientsOf(p * q);
+                        vector<double> a = coefficientsOf(p), b = coefficientsOf(q);
+                        double error = 0;
+                        for (double x : xs)
+                            error = max(error, relativeError(referenceEvaluate(r, x), referenceEvaluate(a, x) * referenceEvaluate(b, x)));
+                        return error;
+                    }});
+
+    list.push_back({"evaluate", 1000,
+                    [](Polynomial &p, const Polynomial &, double x, double)
+                    {
+                        double y = p.evaluate(x);
+                        doNotOptimize(y);
+                    },
+                    [](Polynomial &p, const Polynomial &, const vector<double> &xs)
+                    {
+                        vector<double> a = coefficientsOf(p);
+                        double error = 0;
+                        for (double x : xs)
+                            error = max(error, relativeError(p.evaluate(x), referenceEvaluate(a, x)));
+                        return error;
+                    }});
+
+    list.push_back({"compose", 100,
+                    [](Polynomial &p, const Polynomial &q, double, double)
+                    {
+                        Polynomial r = p.compose(q);
+                        doNotOptimize(r);
+                    },
+                    [](Polynomial &p, const Polynomial &q, const vector<double> &xs)
+                    {
+                        vector<double> r = coefficientsOf(p.compose(q));
+                        vector<double> a = coefficientsOf(p), b = coefficientsOf(q);
+                        double error = 0;
+                        for (double x : xs)
+                            error = max(error, relativeError(referenceEvaluate(r, x), referenceEvaluate(a, referenceEvaluate(b, x))));
+                        return error;
+                    }});
+
+    list.push_back({"derivative", 1000,
+                    [](Polynomial &p, const Polynomial &, double, double)
+                    {
+                        Polynomial r = p.derivative();
+                        doNotOptimize(r);
+                    },
+                    [](Polynomial &p, const Polynomial &, const vector<double> &xs)
+                    {
+                        vector<double> r = coefficientsOf(p.derivative());
+                        vector<double> a = coefficientsOf(p);
+                        double error = 0;
+                        for (double x : xs)
+                        {
+                            long double expected = 0;
+                            for (int i = static_cast<int>(a.size()) - 1; i >= 1; --i)
+                                expected = expected * x + static_cast<long double>(a[i]) * i;
+                            error = max(error, relativeError(referenceEvaluate(r, x), expected));
+                        }
+                        return error;
+                    }});
+
+    list.push_back({"integral", 1000,
+                    [](Polynomial &p, const Polynomial &, double x1, double x2)
+                    {
+                        double y = p.integral(x1, x2);
+                        doNotOptimize(y);
+                    },
+                    [](Polynomial &p, const Polynomial &, const vector<double> &xs)
+                    {
+                        vector<double> a = coefficientsOf(p);
+                        vector<long double> anti(a.size() + 1, 0);
+                        for (size_t k = 0; k < a.size(); ++k)
+                            anti[k + 1] = static_cast<long double>(a[k]) / (k + 1);
+                        auto antiAt = [&](long double x)
+                        {
+                            long double result = 0;
+                            for (int k = static_cast<int>(anti.size()) - 1; k >= 0; --k)
+                                result = result * x + anti[k];
+                            return result;
+                        };
+                        double error = 0;
+                        for (size_t i = 0; i + 1 < xs.size(); ++i)
+                            error = max(error, relativeError(p.integral(xs[i], xs[i + 1]), antiAt(xs[i + 1]) - antiAt(xs[i])));
+                        return error;
+                    }});
+
+    list.push_back({"getRoot", 1000,
+                    [](Polynomial &p, const Polynomial &, double x, double)
+                    {
+                        try
+                        {
+                            double root = p.getRoot(x);
+                            doNotOptimize(root);
+                        }
+                        catch (const runtime_error &)
+                        {
+                            // Non-convergence still costs maxIter iterations
+                        }
+                    },
+                    [](Polynomial &p, const Polynomial &, const vector<double> &xs)
+                    {
+                        // Deviation is the residual |p(root)|; a failed search counts as infinite
+                        vector<double> a = coefficientsOf(p);
+                        double error = 0;
+                        for (double x : xs)
+                        {
+                            try
+                            {
+                                error = max(error, relativeError(referenceEvaluate(a, p.getRoot(x)), 0));
+                            }
+                            catch (const runtime_error &)
+                            {
+                                error = numeric_limits<double>::infinity();
+                            }
+                        }
+                        return error;
+                    }});
+
+    return list;
+}
+
+int main(int argc, char **argv)
+{
+    string outPath;
+    int reps = 15;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        string arg = argv[i];
+        if (arg == "--out")
+            outPath = argv[i + 1];
+        else if (arg == "--reps")
+            reps = max(1, atoi(argv[i + 1]));
+    }
+
+    ofstream file;
+    if (!outPath.empty())
+        file.open(outPath);
+    ostream &out = outPath.empty() ? cout : file;
+    out << "backend,operation,degree,median_ns,allocs_per_call,max_rel_error\n";
+
+    const vector<double> xs = randomPoints(8, 7);
+    for (const Case &c : cases())
+    {
+        for (int degree = 1; degree <= c.maxDegree; degree *= 10)
+        {
+            Polynomial p(randomCoefficients(degree, 1));
+            Polynomial q(randomCoefficients(max(1, degree / 10), 2));
+
+            double error = c.deviation(p, q, xs);
+
+            c.call(p, q, xs[0], xs[1]); // Warm up lazily built state
+            size_t before = allocationCount.load(memory_order_relaxed);
+            c.call(p, q, xs[0], xs[1]);
+            size_t allocations = allocationCount.load(memory_order_relaxed) - before;
+
+            vector<double> samples(reps);
+            for (int r = 0; r < reps; ++r)
+            {
+                auto start = steady_clock::now();
+                c.call(p, q, xs[0], xs[1]);
+                samples[r] = duration<double, nano>(steady_clock::now() - start).count();
+            }
+            sort(samples.begin(), samples.end());
+
+            out << POLY_BACKEND << "," << c.operation << "," << degree << "," << percentile(samples, 0.5) << ","
+                << allocations << "," << error << "\n";
+        }
+    }
+    return 0;
+}
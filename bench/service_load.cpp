@@ -0,0 +1,148 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+#include "../polynomial.h"
+#include "../polynomial_service.h"
+#include "bench_util.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Load generator for the evaluation service. For each client count it keeps
+// that many connections busy for a fixed time, each sending requests of a
+// few points back to back, and reports throughput with p50/p99 latency.
+// Without --socket it starts a server in this process over random
+// polynomials, so the effect of the coalescing window can be measured alone.
+//
+// Usage: service_load [--socket PATH] [--clients 1,4,16] [--points N]
+//                     [--seconds S] [--polynomials N] [--degree N] [--window-us N]
+
+struct Options
+{
+    string socket;
+    vector<int> clients = {1, 4, 16, 64};
+    int points = 4;
+    double seconds = 1.0;
+    int polynomials = 4;
+    int degree = 32;
+    unsigned windowMicros = 100;
+};
+
+static vector<int> parseList(const string &text)
+{
+    vector<int> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ','))
+        values.push_back(stoi(item));
+    return values;
+}
+
+static Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+            throw invalid_argument("Missing value for " + arg);
+        string value = argv[++i];
+        if (arg == "--socket")
+            options.socket = value;
+        else if (arg == "--clients")
+            options.clients = parseList(value);
+        else if (arg == "--points")
+            options.points = max(1, stoi(value));
+        else if (arg == "--seconds")
+            options.seconds = stod(value);
+        else if (arg == "--polynomials")
+            options.polynomials = max(1, stoi(value));
+        else if (arg == "--degree")
+            options.degree = stoi(value);
+        else if (arg == "--window-us")
+            options.windowMicros = stoul(value);
+        else
+            throw invalid_argument("Unknown option " + arg);
+    }
+    return options;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    unique_ptr<PolynomialServer> server;
+    thread serving;
+    string path = options.socket;
+    if (path.empty())
+    {
+        path = "/tmp/polyd_load_" + to_string(getpid()) + ".sock";
+        vector<Polynomial> polynomials;
+        for (int i = 0; i < options.polynomials; ++i)
+            polynomials.push_back(Polynomial(randomCoefficients(options.degree, i + 1)));
+        PolynomialServiceOptions serviceOptions;
+        serviceOptions.windowMicros = options.windowMicros;
+        server = make_unique<PolynomialServer>(polynomials, path, serviceOptions);
+        serving = thread(&PolynomialServer::run, server.get());
+    }
+
+    cout << "clients,requests_per_s,points_per_s,p50_us,p99_us" << endl;
+    for (int clients : options.clients)
+    {
+        vector<vector<double>> latencies(clients);
+        atomic<bool> done{false};
+        vector<thread> threads;
+        for (int c = 0; c < clients; ++c)
+        {
+            threads.emplace_back([&, c]()
+                                 {
+                PolynomialClient client(path);
+                vector<double> xs = randomPoints(options.points, c + 100), out(options.points);
+                uint32_t index = c % options.polynomials;
+                while (!done.load(memory_order_relaxed))
+                {
+                    auto start = steady_clock::now();
+                    client.evaluate(index, xs.data(), xs.size(), out.data());
+                    latencies[c].push_back(duration<double, micro>(steady_clock::now() - start).count());
+                    doNotOptimize(out[0]);
+                } });
+        }
+        this_thread::sleep_for(duration<double>(options.seconds));
+        done.store(true);
+        for (thread &t : threads)
+            t.join();
+
+        vector<double> all;
+        for (const vector<double> &l : latencies)
+            all.insert(all.end(), l.begin(), l.end());
+        sort(all.begin(), all.end());
+        double rate = all.size() / options.seconds;
+        cout << clients << "," << rate << "," << rate * options.points << ","
+             << (all.empty() ? 0 : percentile(all, 0.5)) << "," << (all.empty() ? 0 : percentile(all, 0.99)) << endl;
+    }
+
+    if (server)
+    {
+        server->stop();
+        serving.join();
+        cerr << server->requestCount() << " requests in " << server->batchCount() << " batches" << endl;
+    }
+    return 0;
+}
@@ -2,7 +2,13 @@
 #include <vector>
 #include <stdexcept>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include "../polynomial.h"
+#include "../polynomial_stats.h"
+#include "../polynomial_trace.h"
+#include "../polynomial_view.h"
+#include "../polynomial_format.h"
 
 using namespace std;
 
@@ -14,30 +20,50 @@ void Polynomial::trim()
     }
 }
 
-Polynomial::Polynomial() : coeffs(1, 0.0) {}
+Polynomial::Polynomial() : coeffs(1, 0.0), derivativeCache(nullptr), integralCache(nullptr)
+{
+    POLY_STATS_SCOPE(CONSTRUCT);
+    POLY_STATS_ALLOC(coeffs.size());
+}
 
-Polynomial::Polynomial(const vector<double> &coefficients) : coeffs(coefficients)
+Polynomial::Polynomial(const vector<double> &coefficients)
+    : coeffs(coefficients), derivativeCache(nullptr), integralCache(nullptr)
 {
+    POLY_STATS_SCOPE(CONSTRUCT);
+    POLY_STATS_ALLOC(coeffs.size());
     trim();
 }
 
-Polynomial::Polynomial(const Polynomial &other) : coeffs(other.coeffs) {}
+Polynomial::Polynomial(const Polynomial &other)
+    : coeffs(other.coeffs), derivativeCache(nullptr), integralCache(nullptr)
+{
+    POLY_STATS_SCOPE(COPY);
+    POLY_STATS_ALLOC(coeffs.size());
+}
 
-Polynomial::~Polynomial() {}
+Polynomial::~Polynomial()
+{
+    clearCaches();
+}
 
 Polynomial &Polynomial::operator=(const Polynomial &other)
 {
+    POLY_STATS_SCOPE(ASSIGN);
     if (this != &other)
     {
         coeffs = other.coeffs;
+        POLY_STATS_ALLOC(coeffs.size());
         trim();
+        clearCaches();
     }
     return *this;
 }
 
 Polynomial Polynomial::operator+(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(ADD);
     vector<double> result(max(coeffs.size(), other.coeffs.size()), 0);
+    POLY_STATS_ALLOC(result.size());
     for (size_t i = 0; i < result.size(); ++i)
     {
         if (i < coeffs.size())
@@ -50,7 +76,9 @@ Polynomial Polynomial::operator+(const Polynomial &other) const
 
 Polynomial Polynomial::operator-(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(SUBTRACT);
     vector<double> result(max(coeffs.size(), other.coeffs.size()), 0);
+    POLY_STATS_ALLOC(result.size());
     for (size_t i = 0; i < result.size(); ++i)
     {
         if (i < coeffs.size())
@@ -63,7 +91,10 @@ Polynomial Polynomial::operator-(const Polynomial &other) const
 
 Polynomial Polynomial::operator*(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(MULTIPLY);
+    POLY_TRACE_SPAN("multiply", "lhs_degree", degree(), "rhs_degree", other.degree());
     vector<double> result(coeffs.size() + other.coeffs.size() - 1, 0);
+    POLY_STATS_ALLOC(result.size());
     for (size_t i = 0; i < coeffs.size(); ++i)
     {
         for (size_t j = 0; j < other.coeffs.size(); ++j)
@@ -76,57 +107,67 @@ Polynomial Polynomial::operator*(const Polynomial &other) const
 
 bool Polynomial::operator==(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(EQUALS);
     return coeffs == other.coeffs;
 }
 
-ostream &operator<<(ostream &out, const Polynomial &poly)
+bool Polynomial::equals(const Polynomial &other, double tolerance) const
 {
-    if (poly.coeffs.empty())
+    POLY_STATS_SCOPE(EQUALS);
+    size_t n = max(coeffs.size(), other.coeffs.size());
+    for (size_t i = 0; i < n; ++i)
     {
-        out << "0"; // Handle zero polynomial
-        return out;
+        double a = i < coeffs.size() ? coeffs[i] : 0.0;
+        double b = i < other.coeffs.size() ? other.coeffs[i] : 0.0;
+        if (!(fabs(a - b) <= tolerance))
+            return false;
     }
+    return true;
+}
 
-    bool firstTerm = true; // To handle the sign of the first term
-
-    for (int i = poly.degree(); i >= 0; --i)
+size_t Polynomial::hash() const
+{
+    POLY_STATS_SCOPE(HASH);
+    // FNV-1a over the coefficient bits, skipping trailing zeros so that
+    // polynomials equal under == or equals() at tolerance 0 hash the same.
+    // Polynomials within a positive tolerance usually hash differently.
+    size_t n = coeffs.size();
+    while (n > 0 && coeffs[n - 1] == 0)
+        --n;
+
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; ++i)
     {
-        if (poly.coeffs[i] != 0)
-        {
-            // Skip the constant term (x^0)
-            if (i == 0)
-                continue;
-
-            // Print the sign for the first term
-            if (firstTerm)
-            {
-                out << poly.coeffs[i] << "x^" << i;
-                firstTerm = false; // Set to false after first term
-            }
-            else
-            {
-                out << (poly.coeffs[i] > 0 ? "+" : "")
-                    << poly.coeffs[i] << "x^" << i;
-            }
-        }
+        double c = coeffs[i] == 0 ? 0.0 : coeffs[i]; // Fold -0.0 into 0.0
+        uint64_t bits;
+        memcpy(&bits, &c, sizeof(bits));
+        h = (h ^ bits) * 1099511628211ULL;
     }
+    return static_cast<size_t>(h);
+}
 
-    // Handle the constant term separately if it exists
-    if (poly.coeffs[0] != 0)
-    {
-        out << (firstTerm ? "" : "+") << poly.coeffs[0];
-    }
+ostream &operator<<(ostream &out, const Polynomial &poly)
+{
+    POLY_STATS_SCOPE(OUTPUT);
+    PolynomialFormat fmt;
+    fmt.style = PolynomialFormat::COMPACT;
+    return PolynomialFormatter::write(out, poly, fmt);
+}
 
-    return out;
+Polynomial::operator PolynomialView() const
+{
+    return PolynomialView(span<const double>(coeffs));
 }
 
 int Polynomial::degree() const
 {
+    POLY_STATS_SCOPE(DEGREE);
     return coeffs.empty() ? -1 : static_cast<int>(coeffs.size()) - 1;
 }
 
 double Polynomial::evaluate(double x) const
 {
+    POLY_STATS_SCOPE(EVALUATE);
     double result = 0;
     for (size_t i = 0; i < coeffs.size(); ++i)
     {
@@ -135,8 +176,55 @@ double Polynomial::evaluate(double x) const
     return result;
 }
 
+double Polynomial::evaluateAccurate(double x, double *errorBound) const
+{
+    POLY_STATS_SCOPE(EVALUATE_ACCURATE);
+    return PolynomialView(*this).evaluateAccurate(x, errorBound);
+}
+
+void Polynomial::evaluateAccurate(const double *xs, double *out, size_t n, double *errorBounds) const
+{
+    POLY_STATS_SCOPE(EVALUATE_ACCURATE);
+    PolynomialView(*this).evaluateAccurate(xs, out, n, errorBounds);
+}
+
+void Polynomial::evaluateInterval(double lo, double hi, double &outLo, double &outHi) const
+{
+    POLY_STATS_SCOPE(EVALUATE_INTERVAL);
+    PolynomialView(*this).evaluateInterval(lo, hi, outLo, outHi);
+}
+
+void Polynomial::evaluateInterval(const double *los, const double *his, double *outLo, double *outHi, size_t n) const
+{
+    POLY_STATS_SCOPE(EVALUATE_INTERVAL);
+    PolynomialView(*this).evaluateInterval(los, his, outLo, outHi, n);
+}
+
+void Polynomial::evaluateWithDerivatives(double x, int k, double *out) const
+{
+    POLY_STATS_SCOPE(EVALUATE_DERIVATIVES);
+    PolynomialView(*this).evaluateWithDerivatives(x, k, out);
+}
+
+void Polynomial::evaluateWithDerivatives(const double *xs, size_t n, int k, double *out) const
+{
+    POLY_STATS_SCOPE(EVALUATE_DERIVATIVES);
+    for (size_t i = 0; i < n; ++i)
+    {
+        evaluateWithDerivatives(xs[i], k, out + i * (k + 1));
+    }
+}
+
+Polynomial::Plan Polynomial::plan() const
+{
+    POLY_STATS_SCOPE(PLAN);
+    return Plan(coeffs);
+}
+
 Polynomial Polynomial::compose(const Polynomial &q) const
 {
+    POLY_STATS_SCOPE(COMPOSE);
+    POLY_TRACE_SPAN("compose", "outer_degree", degree(), "inner_degree", q.degree());
     Polynomial result({0}); // Start with zero polynomial
     for (int i = degree(); i >= 0; --i)
     {
@@ -147,10 +235,12 @@ Polynomial Polynomial::compose(const Polynomial &q) const
 
 Polynomial Polynomial::derivative() const
 {
+    POLY_STATS_SCOPE(DERIVATIVE);
     if (coeffs.size() <= 1)
         return Polynomial();
 
     vector<double> derivCoeffs(coeffs.size() - 1);
+    POLY_STATS_ALLOC(derivCoeffs.size());
 
     for (size_t i = 1; i < coeffs.size(); ++i)
     {
@@ -162,7 +252,9 @@ Polynomial Polynomial::derivative() const
 
 Polynomial Polynomial::integral() const
 {
+    POLY_STATS_SCOPE(INTEGRAL);
     vector<double> intCoeffs(coeffs.size() + 1);
+    POLY_STATS_ALLOC(intCoeffs.size());
 
     for (size_t i = 0; i < coeffs.size(); ++i)
     {
@@ -174,8 +266,9 @@ Polynomial Polynomial::integral() const
 
 double Polynomial::integral(double x1, double x2) const
 {
-    // Get the antiderivative
-    Polynomial antiderivative = this->integral();
+    POLY_STATS_SCOPE(INTEGRAL_RANGE);
+    // Get the antiderivative (built once, then reused)
+    const Polynomial &antiderivative = cachedIntegral();
 
     // Evaluate at x2 and x1
     return antiderivative.evaluate(x2) - antiderivative.evaluate(x1);
@@ -183,12 +276,16 @@ double Polynomial::integral(double x1, double x2) const
 
 double Polynomial::getRoot(double guess, double tolerance, int maxIter)
 {
+    POLY_STATS_SCOPE(GET_ROOT);
+    POLY_TRACE_SPAN("getRoot", "degree", degree(), "max_iter", maxIter);
     double x = guess;
+    double values[2]; // f(x) and f'(x) from a single pass
 
     for (int iter = 0; iter < maxIter; ++iter)
     {
-        double f_x = evaluate(x);
-        double f_prime_x = derivative().evaluate(x);
+        evaluateWithDerivatives(x, 1, values);
+        double f_x = values[0];
+        double f_prime_x = values[1];
 
         if (fabs(f_prime_x) < tolerance)
             break; // Avoid division by zero
@@ -202,14 +299,54 @@ double Polynomial::getRoot(double guess, double tolerance, int maxIter)
     throw runtime_error("Root not found within the maximum iterations.");
 }
 
+const Polynomial &Polynomial::cachedDerivative() const
+{
+    POLY_STATS_SCOPE(CACHED_DERIVATIVE);
+    Polynomial *cached = derivativeCache.load(memory_order_acquire);
+    if (cached == nullptr)
+    {
+        Polynomial *built = new Polynomial(derivative());
+        if (derivativeCache.compare_exchange_strong(cached, built, memory_order_acq_rel))
+            cached = built;
+        else
+            delete built; // Another reader published first
+    }
+    return *cached;
+}
+
+const Polynomial &Polynomial::cachedIntegral() const
+{
+    POLY_STATS_SCOPE(CACHED_INTEGRAL);
+    Polynomial *cached = integralCache.load(memory_order_acquire);
+    if (cached == nullptr)
+    {
+        Polynomial *built = new Polynomial(integral());
+        if (integralCache.compare_exchange_strong(cached, built, memory_order_acq_rel))
+            cached = built;
+        else
+            delete built;
+    }
+    return *cached;
+}
+
+void Polynomial::clearCaches()
+{
+    delete derivativeCache.exchange(nullptr);
+    delete integralCache.exchange(nullptr);
+}
+
 void Polynomial::setCoefficients(const vector<double> &coefficients)
 {
+    POLY_STATS_SCOPE(SET_COEFFICIENTS);
     coeffs = coefficients;
+    POLY_STATS_ALLOC(coeffs.size());
     trim();
+    clearCaches();
 }
 
 double Polynomial::getCoefficient(int degree) const
 {
+    POLY_STATS_SCOPE(GET_COEFFICIENT);
     if (degree < 0 || degree >= static_cast<int>(coeffs.size()))
         throw out_of_range("Degree out of range.");
 
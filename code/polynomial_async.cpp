@@ -0,0 +1,187 @@
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "../polynomial_async.h"
+
+namespace polyasync
+{
+    namespace
+    {
+        // Points evaluated between two cancellation checks
+        const size_t CHUNK = 4096;
+
+        class Pool
+        {
+        private:
+            mutex lock;
+            condition_variable changed;
+            deque<function<void()>> calls;
+            vector<thread> threads;
+            size_t maxQueued;
+            bool stopping = false;
+
+            void run()
+            {
+                while (true)
+                {
+                    function<void()> call;
+                    {
+                        unique_lock<mutex> guard(lock);
+                        changed.wait(guard, [&]()
+                                     { return stopping || !calls.empty(); });
+                        if (calls.empty())
+                            return;
+                        call = move(calls.front());
+                        calls.pop_front();
+                    }
+                    call();
+                }
+            }
+
+        public:
+            Pool(unsigned threadCount, size_t maxQueued) : maxQueued(max<size_t>(maxQueued, 1))
+            {
+                for (unsigned i = 0; i < max(threadCount, 1u); ++i)
+                {
+                    threads.emplace_back(&Pool::run, this);
+                }
+            }
+
+            ~Pool()
+            {
+                {
+                    lock_guard<mutex> guard(lock);
+                    stopping = true;
+                }
+                changed.notify_all();
+                for (thread &t : threads)
+                {
+                    t.join();
+                }
+            }
+
+            void submit(function<void()> call)
+            {
+                {
+                    lock_guard<mutex> guard(lock);
+                    if (calls.size() >= maxQueued)
+                        throw QueueFull();
+                    calls.push_back(move(call));
+                }
+                changed.notify_one();
+            }
+
+            size_t size()
+            {
+                lock_guard<mutex> guard(lock);
+                return calls.size();
+            }
+        };
+
+        mutex poolLock;
+        unique_ptr<Pool> current;
+
+        Pool &pool()
+        {
+            lock_guard<mutex> guard(poolLock);
+            if (!current)
+                current = make_unique<Pool>(max(1u, thread::hardware_concurrency()), 1024);
+            return *current;
+        }
+
+        // Queue work and hand back its future. The promise is shared because
+        // std::function needs a copyable callable.
+        template <typename T>
+        future<T> submit(CancellationToken token, function<T()> work)
+        {
+            auto promise = make_shared<std::promise<T>>();
+            future<T> result = promise->get_future();
+            pool().submit([promise, token, work = move(work)]()
+                          {
+                try
+                {
+                    if (token.cancelled())
+                        throw Cancelled();
+                    promise->set_value(work());
+                }
+                catch (...)
+                {
+                    promise->set_exception(current_exception());
+                } });
+            return result;
+        }
+    }
+
+    CancellationToken::CancellationToken() : flag(make_shared<atomic<bool>>(false)) {}
+
+    void CancellationToken::cancel() const
+    {
+        flag->store(true, memory_order_relaxed);
+    }
+
+    bool CancellationToken::cancelled() const
+    {
+        return flag->load(memory_order_relaxed);
+    }
+
+    void configure(unsigned threads, size_t maxQueued)
+    {
+        unique_ptr<Pool> old;
+        {
+            lock_guard<mutex> guard(poolLock);
+            old = move(current);
+            current = make_unique<Pool>(threads, maxQueued);
+        }
+        // Destroying the old pool drains its queue and joins its threads
+    }
+
+    size_t queued()
+    {
+        return pool().size();
+    }
+
+    future<Polynomial> multiplyAsync(const Polynomial &a, const Polynomial &b, CancellationToken token)
+    {
+        return submit<Polynomial>(token, [a, b]()
+                                  { return a * b; });
+    }
+
+    future<Polynomial> composeAsync(const Polynomial &p, const Polynomial &q, CancellationToken token)
+    {
+        return submit<Polynomial>(token, [p, q]()
+                                  { return p.compose(q); });
+    }
+
+    future<vector<double>> rootsAsync(const Polynomial &p, vector<double> guesses, double tolerance, int maxIter,
+                                      CancellationToken token)
+    {
+        return submit<vector<double>>(token, [p, guesses = move(guesses), tolerance, maxIter, token]()
+                                      {
+            Polynomial poly = p; // getRoot is not const
+            vector<double> roots(guesses.size());
+            for (size_t i = 0; i < guesses.size(); ++i)
+            {
+                if (token.cancelled())
+                    throw Cancelled();
+                roots[i] = poly.getRoot(guesses[i], tolerance, maxIter);
+            }
+            return roots; });
+    }
+
+    future<vector<double>> evaluateAsync(const Polynomial &p, vector<double> xs, CancellationToken token)
+    {
+        return submit<vector<double>>(token, [p, xs = move(xs), token]()
+                                      {
+            Polynomial::Plan plan = p.plan();
+            vector<double> out(xs.size());
+            for (size_t i = 0; i < xs.size(); i += CHUNK)
+            {
+                if (token.cancelled())
+                    throw Cancelled();
+                plan.evaluate(xs.data() + i, out.data() + i, min(CHUNK, xs.size() - i));
+            }
+            return out; });
+    }
+}
@@ -0,0 +1,169 @@
+#include <stdexcept>
+#include "../polynomial_batch.h"
+
+// Constructors
+PolynomialBatch::PolynomialBatch() : count(0), deg(0) {}
+
+PolynomialBatch::PolynomialBatch(size_t count, int degree)
+    : coeffs((degree + 1) * count, 0.0), count(count), deg(degree) {}
+
+PolynomialBatch::PolynomialBatch(const vector<Polynomial> &polys) : count(polys.size()), deg(0)
+{
+    for (const Polynomial &p : polys)
+    {
+        deg = max(deg, p.degree());
+    }
+    coeffs.assign((deg + 1) * count, 0.0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (int k = 0; k <= polys[i].degree(); ++k)
+        {
+            coeffs[k * count + i] = polys[i].getCoefficient(k);
+        }
+    }
+}
+
+// Arithmetic operators
+PolynomialBatch PolynomialBatch::operator+(const PolynomialBatch &other) const
+{
+    if (count != other.count)
+        throw invalid_argument("Batch sizes differ.");
+
+    PolynomialBatch result(count, max(deg, other.deg));
+    for (size_t i = 0; i < coeffs.size(); ++i)
+    {
+        result.coeffs[i] += coeffs[i];
+    }
+    for (size_t i = 0; i < other.coeffs.size(); ++i)
+    {
+        result.coeffs[i] += other.coeffs[i];
+    }
+    return result;
+}
+
+PolynomialBatch PolynomialBatch::operator-(const PolynomialBatch &other) const
+{
+    if (count != other.count)
+        throw invalid_argument("Batch sizes differ.");
+
+    PolynomialBatch result(count, max(deg, other.deg));
+    for (size_t i = 0; i < coeffs.size(); ++i)
+    {
+        result.coeffs[i] += coeffs[i];
+    }
+    for (size_t i = 0; i < other.coeffs.size(); ++i)
+    {
+        result.coeffs[i] -= other.coeffs[i];
+    }
+    return result;
+}
+
+PolynomialBatch PolynomialBatch::operator*(const PolynomialBatch &other) const
+{
+    if (count != other.count)
+        throw invalid_argument("Batch sizes differ.");
+
+    PolynomialBatch result(count, deg + other.deg);
+    for (int i = 0; i <= deg; ++i)
+    {
+        const double *a = coeffs.data() + i * count;
+        for (int j = 0; j <= other.deg; ++j)
+        {
+            const double *b = other.coeffs.data() + j * count;
+            double *r = result.coeffs.data() + (i + j) * count;
+            for (size_t l = 0; l < count; ++l)
+            {
+                r[l] += a[l] * b[l];
+            }
+        }
+    }
+    return result;
+}
+
+// Utility functions
+size_t PolynomialBatch::size() const
+{
+    return count;
+}
+
+int PolynomialBatch::degree() const
+{
+    return deg;
+}
+
+void PolynomialBatch::evaluate(const double *xs, double *out) const
+{
+    // Horner with one lane per polynomial
+    for (size_t l = 0; l < count; ++l)
+    {
+        out[l] = 0.0;
+    }
+    for (int k = deg; k >= 0; --k)
+    {
+        const double *c = coeffs.data() + k * count;
+        for (size_t l = 0; l < count; ++l)
+        {
+            out[l] = out[l] * xs[l] + c[l];
+        }
+    }
+}
+
+void PolynomialBatch::evaluate(double x, double *out) const
+{
+    for (size_t l = 0; l < count; ++l)
+    {
+        out[l] = 0.0;
+    }
+    for (int k = deg; k >= 0; --k)
+    {
+        const double *c = coeffs.data() + k * count;
+        for (size_t l = 0; l < count; ++l)
+        {
+            out[l] = out[l] * x + c[l];
+        }
+    }
+}
+
+PolynomialBatch PolynomialBatch::derivative() const
+{
+    if (deg == 0)
+        return PolynomialBatch(count, 0);
+
+    PolynomialBatch result(count, deg - 1);
+    for (int k = 1; k <= deg; ++k)
+    {
+        const double *c = coeffs.data() + k * count;
+        double *r = result.coeffs.data() + (k - 1) * count;
+        for (size_t l = 0; l < count; ++l)
+        {
+            r[l] = c[l] * k;
+        }
+    }
+    return result;
+}
+
+Polynomial PolynomialBatch::get(size_t index) const
+{
+    if (index >= count)
+        throw out_of_range("Index out of range.");
+    vector<double> result(deg + 1);
+    for (int k = 0; k <= deg; ++k)
+    {
+        result[k] = coeffs[k * count + index];
+    }
+    return Polynomial(result);
+}
+
+double PolynomialBatch::getCoefficient(size_t index, int degree) const
+{
+    if (index >= count || degree < 0 || degree > deg)
+        return 0.0;
+    return coeffs[degree * count + index];
+}
+
+void PolynomialBatch::setCoefficient(size_t index, int degree, double value)
+{
+    if (index >= count || degree < 0 || degree > deg)
+        throw out_of_range("Index or degree out of range.");
+    coeffs[degree * count + index] = value;
+}
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include "../polynomial_bernstein.h"
+#include "../polynomial_tasks.h"
+
+// Constructors
+BernsteinPolynomial::BernsteinPolynomial() : coeffs(1, 0.0), a(0), b(1) {}
+
+BernsteinPolynomial::BernsteinPolynomial(const vector<double> &coefficients, double a, double b)
+    : coeffs(coefficients), a(a), b(b)
+{
+    if (coeffs.empty())
+        coeffs.push_back(0.0);
+    if (!(a < b))
+        throw invalid_argument("Bernstein interval must have a < b.");
+}
+
+BernsteinPolynomial::BernsteinPolynomial(const Polynomial &p, double a, double b) : a(a), b(b)
+{
+    if (!(a < b))
+        throw invalid_argument("Bernstein interval must have a < b.");
+
+    int n = max(p.degree(), 0);
+    vector<double> m(n + 1);
+    for (int k = 0; k <= n; ++k)
+    {
+        m[k] = k <= p.degree() ? p.getCoefficient(k) : 0.0; // The zero polynomial may have no coefficients
+    }
+
+    // Taylor shift to x - a, then scale so t = (x - a) / (b - a)
+    for (int i = 0; i < n; ++i)
+    {
+        for (int k = n - 1; k >= i; --k)
+        {
+            m[k] += a * m[k + 1];
+        }
+    }
+    double w = b - a, power = 1;
+    for (int k = 0; k <= n; ++k)
+    {
+        m[k] *= power;
+        power *= w;
+    }
+
+    // b_i = sum over j <= i of C(i, j) / C(n, j) m_j
+    coeffs.assign(n + 1, 0.0);
+    for (int j = 0; j <= n; ++j)
+    {
+        // ratio = C(i, j) / C(n, j), starting at i = j where it is 1 / C(n, j)
+        double ratio = 1;
+        for (int k = 0; k < j; ++k)
+        {
+            ratio = ratio * (k + 1) / (n - k);
+        }
+        for (int i = j; i <= n; ++i)
+        {
+            coeffs[i] += ratio * m[j];
+            ratio = ratio * (i + 1) / (i + 1 - j);
+        }
+    }
+}
+
+void BernsteinPolynomial::subdivide(span<double> coeffs, double t, span<double> right)
+{
+    size_t n = coeffs.size();
+    if (right.size() < n)
+        throw invalid_argument("Output span is too small.");
+    // Row r of the de Casteljau triangle overwrites coeffs[r..n); its first
+    // entry is the left piece's b_r and its last the right piece's b_(n-1-r)
+    for (size_t r = 0; r < n; ++r)
+    {
+        right[n - 1 - r] = coeffs[n - 1];
+        for (size_t i = n - 1; i > r; --i)
+        {
+            coeffs[i] = coeffs[i - 1] + t * (coeffs[i] - coeffs[i - 1]);
+        }
+    }
+}
+
+// Utility functions
+Polynomial BernsteinPolynomial::toPolynomial() const
+{
+    int n = degree();
+    // Monomial coefficients in t: m_j = C(n, j) sum over i <= j of (-1)^(j - i) C(j, i) b_i
+    vector<double> m(n + 1, 0.0);
+    double binomN = 1;
+    for (int j = 0; j <= n; ++j)
+    {
+        double binomJ = 1, sum = 0;
+        for (int i = 0; i <= j; ++i)
+        {
+            sum += ((j - i) % 2 ? -binomJ : binomJ) * coeffs[i];
+            binomJ = binomJ * (j - i) / (i + 1);
+        }
+        m[j] = binomN * sum;
+        binomN = binomN * (n - j) / (j + 1);
+    }
+
+    // Undo the scaling, then shift back by -a
+    double w = 1 / (b - a), power = 1;
+    for (int k = 0; k <= n; ++k)
+    {
+        m[k] *= power;
+        power *= w;
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        for (int k = n - 1; k >= i; --k)
+        {
+            m[k] -= a * m[k + 1];
+        }
+    }
+    return Polynomial(m);
+}
+
+int BernsteinPolynomial::degree() const
+{
+    return static_cast<int>(coeffs.size()) - 1;
+}
+
+double BernsteinPolynomial::lower() const
+{
+    return a;
+}
+
+double BernsteinPolynomial::upper() const
+{
+    return b;
+}
+
+const vector<double> &BernsteinPolynomial::coefficients() const
+{
+    return coeffs;
+}
+
+double BernsteinPolynomial::evaluate(double x) const
+{
+    // Horner in t / (1 - t) or (1 - t) / t, whichever is at most 1
+    int n = degree();
+    double t = (x - a) / (b - a), s = 1 - t;
+    if (n == 0)
+        return coeffs[0];
+
+    double result, scale, factor = 1, binom = 1;
+    if (t <= 0.5)
+    {
+        double ratio = t / s;
+        result = coeffs[0];
+        for (int i = 1; i <= n; ++i)
+        {
+            binom = binom * (n - i + 1) / i;
+            factor *= ratio;
+            result += coeffs[i] * binom * factor;
+        }
+        scale = pow(s, n);
+    }
+    else
+    {
+        double ratio = s / t;
+        result = coeffs[n];
+        for (int i = 1; i <= n; ++i)
+        {
+            binom = binom * (n - i + 1) / i;
+            factor *= ratio;
+            result += coeffs[n - i] * binom * factor;
+        }
+        scale = pow(t, n);
+    }
+    return result * scale;
+}
+
+void BernsteinPolynomial::bounds(double &lo, double &hi) const
+{
+    auto [minIt, maxIt] = minmax_element(coeffs.begin(), coeffs.end());
+    lo = *minIt;
+    hi = *maxIt;
+}
+
+void BernsteinPolynomial::elevate()
+{
+    // b'_i = i / (n + 1) b_(i-1) + (1 - i / (n + 1)) b_i, written from the top
+    int n = degree();
+    coeffs.push_back(coeffs[n]);
+    for (int i = n; i > 0; --i)
+    {
+        double r = static_cast<double>(i) / (n + 1);
+        coeffs[i] = r * coeffs[i - 1] + (1 - r) * coeffs[i];
+    }
+}
+
+void BernsteinPolynomial::subdivide(double x, BernsteinPolynomial &right)
+{
+    if (!(x > a && x < b))
+        throw invalid_argument("Subdivision point must lie inside the interval.");
+    right.coeffs.resize(coeffs.size());
+    subdivide(coeffs, (x - a) / (b - a), right.coeffs);
+    right.a = x;
+    right.b = b;
+    b = x;
+}
+
+namespace
+{
+    // Where the convex hull of the control points (i / n, c_i) meets zero,
+    // as [tMin, tMax] in [0, 1]; false if it does not
+    bool clip(const vector<double> &c, double &tMin, double &tMax)
+    {
+        int n = static_cast<int>(c.size()) - 1;
+        tMin = 1;
+        tMax = 0;
+        for (int i = 0; i <= n; ++i)
+        {
+            if (c[i] == 0)
+            {
+                tMin = min(tMin, static_cast<double>(i) / n);
+                tMax = max(tMax, static_cast<double>(i) / n);
+            }
+            for (int j = i + 1; j <= n; ++j)
+            {
+                if ((c[i] < 0) != (c[j] < 0) && c[i] != 0 && c[j] != 0)
+                {
+                    double t = (i + (j - i) * c[i] / (c[i] - c[j])) / n;
+                    tMin = min(tMin, t);
+                    tMax = max(tMax, t);
+                }
+            }
+        }
+        return tMin <= tMax;
+    }
+
+    struct RootSearch
+    {
+        double tolerance;
+        double scale; // Largest |b_i| of the whole polynomial
+        mutex lock;
+        vector<double> roots;
+
+        void report(double root)
+        {
+            lock_guard<mutex> guard(lock);
+            roots.push_back(root);
+        }
+
+        // A piece whose hull stays on one side of zero but touches it within
+        // rounding may hold an even-multiplicity root: that is a simple root
+        // of the derivative where p is itself negligible.
+        void searchTangent(const BernsteinPolynomial &piece)
+        {
+            const vector<double> &c = piece.coefficients();
+            int n = piece.degree();
+            double smallest = fabs(c[0]);
+            for (double v : c)
+            {
+                smallest = min(smallest, fabs(v));
+            }
+            if (n == 0 || smallest > tolerance * scale)
+                return;
+
+            vector<double> slope(n);
+            for (int i = 0; i < n; ++i)
+            {
+                slope[i] = n * (c[i + 1] - c[i]);
+            }
+            for (double r : BernsteinPolynomial(slope, piece.lower(), piece.upper()).roots(tolerance))
+            {
+                if (fabs(piece.evaluate(r)) <= tolerance * scale)
+                    report(r);
+            }
+        }
+
+        void search(BernsteinPolynomial piece, int depth)
+        {
+            polytasks::TaskGroup group;
+            while (true)
+            {
+                const vector<double> &c = piece.coefficients();
+                double tMin, tMax;
+                if (!clip(c, tMin, tMax))
+                {
+                    searchTangent(piece);
+                    break;
+                }
+
+                double a = piece.lower(), w = piece.upper() - a;
+                double lo = a + tMin * w, hi = a + tMax * w;
+                if (hi - lo <= tolerance)
+                {
+                    report((lo + hi) / 2);
+                    break;
+                }
+                // The hull has stopped shrinking; do not guess a root
+                if (depth > 200)
+                    break;
+
+                BernsteinPolynomial right;
+                if (tMax - tMin > 0.8)
+                {
+                    // Clipping barely helps: several roots, split in half
+                    piece.subdivide(a + w / 2, right);
+                    group.spawn([this, right, depth]()
+                                { search(right, depth + 1); });
+                }
+                else
+                {
+                    // Keep only [lo, hi], widened slightly against rounding
+                    double margin = 1e-3 * (hi - lo) + tolerance / 4;
+                    lo = max(a, lo - margin);
+                    hi = min(piece.upper(), hi + margin);
+                    if (lo > a)
+                    {
+                        piece.subdivide(lo, right);
+                        swap(piece, right);
+                    }
+                    if (hi < piece.upper())
+                        piece.subdivide(hi, right);
+                }
+                ++depth;
+            }
+            group.sync();
+        }
+    };
+}
+
+vector<double> BernsteinPolynomial::roots(double tolerance) const
+{
+    // Constants have no isolated roots
+    if (all_of(coeffs.begin() + 1, coeffs.end(), [&](double c)
+               { return c == coeffs[0]; }))
+        return {};
+
+    RootSearch search;
+    search.tolerance = tolerance;
+    search.scale = 0;
+    for (double c : coeffs)
+    {
+        search.scale = max(search.scale, fabs(c));
+    }
+    search.search(*this, 0);
+
+    // A root on a split point can be found from both sides, and rounding can
+    // show a multiple root as a pair of close sign changes. Neighbours with
+    // |p| negligible between them are one root, reported at the cluster's middle.
+    vector<double> &found = search.roots;
+    sort(found.begin(), found.end());
+    vector<double> result;
+    double first = 0, last = 0;
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        double r = found[i];
+        bool same = i > 0 && (r - last <= 2 * tolerance || fabs(evaluate((last + r) / 2)) <= tolerance * search.scale);
+        if (i > 0 && !same)
+            result.push_back((first + last) / 2);
+        if (!same)
+            first = r;
+        last = r;
+    }
+    if (!found.empty())
+        result.push_back((first + last) / 2);
+    return result;
+}
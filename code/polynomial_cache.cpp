@@ -0,0 +1,117 @@
+#include "../polynomial_cache.h"
+
+PolynomialCache::PolynomialCache(size_t capacity, size_t shardCount)
+    : shards(max<size_t>(shardCount, 1))
+{
+    shardCapacity = max<size_t>(capacity / shards.size(), 1);
+}
+
+template <typename Compute>
+Polynomial PolynomialCache::lookup(Operation op, const Polynomial &a, const Polynomial &b, Compute compute)
+{
+    size_t key = a.hash() * 31 + b.hash();
+    key = key * 31 + op;
+    Shard &shard = shards[key % shards.size()];
+
+    {
+        lock_guard<mutex> guard(shard.lock);
+        auto range = shard.index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            Entry &entry = *it->second;
+            if (entry.op == op && entry.a == a && entry.b == b)
+            {
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                ++shard.hits;
+                return entry.result;
+            }
+        }
+        ++shard.misses;
+    }
+
+    // Compute outside the lock; a concurrent miss on the same key only costs
+    // a duplicate computation
+    Polynomial result = compute();
+
+    lock_guard<mutex> guard(shard.lock);
+    shard.entries.push_front({op, a, b, key, result});
+    shard.index.emplace(key, shard.entries.begin());
+    if (shard.entries.size() > shardCapacity)
+    {
+        Entry &oldest = shard.entries.back();
+        auto range = shard.index.equal_range(oldest.key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (&*it->second == &oldest)
+            {
+                shard.index.erase(it);
+                break;
+            }
+        }
+        shard.entries.pop_back();
+    }
+    return result;
+}
+
+Polynomial PolynomialCache::multiply(const Polynomial &a, const Polynomial &b)
+{
+    return lookup(MULTIPLY, a, b, [&]()
+                  { return a * b; });
+}
+
+Polynomial PolynomialCache::compose(const Polynomial &p, const Polynomial &q)
+{
+    return lookup(COMPOSE, p, q, [&]()
+                  { return p.compose(q); });
+}
+
+Polynomial PolynomialCache::derivative(const Polynomial &p)
+{
+    return lookup(DERIVATIVE, p, Polynomial(), [&]()
+                  { return p.derivative(); });
+}
+
+size_t PolynomialCache::hitCount() const
+{
+    size_t total = 0;
+    for (const Shard &shard : shards)
+    {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.hits;
+    }
+    return total;
+}
+
+size_t PolynomialCache::missCount() const
+{
+    size_t total = 0;
+    for (const Shard &shard : shards)
+    {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.misses;
+    }
+    return total;
+}
+
+size_t PolynomialCache::size() const
+{
+    size_t total = 0;
+    for (const Shard &shard : shards)
+    {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+void PolynomialCache::clear()
+{
+    for (Shard &shard : shards)
+    {
+        lock_guard<mutex> guard(shard.lock);
+        shard.entries.clear();
+        shard.index.clear();
+        shard.hits = 0;
+        shard.misses = 0;
+    }
+}
@@ -0,0 +1,176 @@
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../polynomial_catalog.h"
+
+// The reader hands out pointers into the mapping, which is only valid when
+// the host byte order matches the file
+static_assert(endian::native == endian::little, "Polynomial catalogs require a little-endian host.");
+
+static const char MAGIC[8] = {'P', 'O', 'L', 'Y', 'C', 'A', 'T', '\0'};
+static const size_t HEADER_SIZE = 64;
+
+struct CatalogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t count;
+    uint64_t indexOffset;
+    uint64_t fileSize;
+    unsigned char reserved[24];
+};
+static_assert(sizeof(CatalogHeader) == HEADER_SIZE, "Catalog header must be 64 bytes.");
+
+// Writer
+PolynomialCatalogWriter::PolynomialCatalogWriter(const string &path) : offset(0), path(path)
+{
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        throw runtime_error("Cannot open " + path + " for writing.");
+    writeHeader(0, 0); // Placeholder until close()
+}
+
+PolynomialCatalogWriter::~PolynomialCatalogWriter()
+{
+    if (file != nullptr)
+    {
+        try
+        {
+            close();
+        }
+        catch (const exception &)
+        {
+            // Destructors must not throw; the catalog is left unreadable
+        }
+    }
+}
+
+void PolynomialCatalogWriter::writeBytes(const void *data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, file) != size)
+        throw runtime_error("Write to " + path + " failed.");
+    offset += size;
+}
+
+void PolynomialCatalogWriter::pad()
+{
+    static const unsigned char zeros[ALIGNMENT] = {};
+    writeBytes(zeros, (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT);
+}
+
+void PolynomialCatalogWriter::writeHeader(uint64_t count, uint64_t indexOffset)
+{
+    CatalogHeader header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count = count;
+    header.indexOffset = indexOffset;
+    header.fileSize = offset;
+    writeBytes(&header, sizeof(header));
+}
+
+void PolynomialCatalogWriter::add(PolynomialView poly)
+{
+    add(poly.coefficients());
+}
+
+void PolynomialCatalogWriter::add(span<const double> coefficients)
+{
+    if (file == nullptr)
+        throw logic_error("Catalog writer is closed.");
+    pad();
+    index.push_back(offset);
+    index.push_back(coefficients.size());
+    writeBytes(coefficients.data(), coefficients.size_bytes());
+}
+
+void PolynomialCatalogWriter::close()
+{
+    if (file == nullptr)
+        return;
+
+    pad();
+    uint64_t indexOffset = offset;
+    writeBytes(index.data(), index.size() * sizeof(uint64_t));
+
+    uint64_t fileSize = offset;
+    if (fseek(file, 0, SEEK_SET) != 0)
+        throw runtime_error("Seek in " + path + " failed.");
+    offset = fileSize;
+    writeHeader(index.size() / 2, indexOffset);
+
+    bool ok = fclose(file) == 0;
+    file = nullptr;
+    if (!ok)
+        throw runtime_error("Closing " + path + " failed.");
+}
+
+// Reader
+PolynomialCatalog::PolynomialCatalog(const string &path) : base(nullptr), length(0), index(nullptr), count(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Cannot open " + path + ".");
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(HEADER_SIZE))
+    {
+        ::close(fd);
+        throw runtime_error(path + " is not a polynomial catalog.");
+    }
+    length = info.st_size;
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED)
+        throw runtime_error("Cannot map " + path + ".");
+    base = static_cast<const unsigned char *>(mapping);
+
+    CatalogHeader header;
+    memcpy(&header, base, sizeof(header));
+    bool valid = memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header.version == PolynomialCatalogWriter::VERSION &&
+                 header.fileSize == length &&
+                 header.indexOffset % sizeof(uint64_t) == 0 &&
+                 header.indexOffset <= length &&
+                 header.count <= (length - header.indexOffset) / (2 * sizeof(uint64_t));
+    if (valid)
+    {
+        count = header.count;
+        index = reinterpret_cast<const uint64_t *>(base + header.indexOffset);
+        for (size_t i = 0; i < count && valid; ++i)
+        {
+            uint64_t offset = index[2 * i], n = index[2 * i + 1];
+            valid = offset % PolynomialCatalogWriter::ALIGNMENT == 0 && offset <= length &&
+                    n <= (length - offset) / sizeof(double);
+        }
+    }
+    if (!valid)
+    {
+        munmap(const_cast<unsigned char *>(base), length);
+        throw runtime_error(path + " is not a valid version 1 polynomial catalog.");
+    }
+}
+
+PolynomialCatalog::~PolynomialCatalog()
+{
+    munmap(const_cast<unsigned char *>(base), length);
+}
+
+size_t PolynomialCatalog::size() const
+{
+    return count;
+}
+
+PolynomialView PolynomialCatalog::operator[](size_t i) const
+{
+    if (i >= count)
+        throw out_of_range("Catalog index out of range.");
+    const double *coefficients = reinterpret_cast<const double *>(base + index[2 * i]);
+    return PolynomialView(span<const double>(coefficients, index[2 * i + 1]));
+}
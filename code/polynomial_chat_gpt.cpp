@@ -1,21 +1,45 @@
+#include <cstdint>
+#include <cstring>
 #include "../polynomial.h"
+#include "../polynomial_stats.h"
+#include "../polynomial_trace.h"
+#include "../polynomial_view.h"
+#include "../polynomial_format.h"
 
 // Constructors
-Polynomial::Polynomial() : coeffs(1, 0.0) {} // Default constructor (constant 0)
+Polynomial::Polynomial() : coeffs(1, 0.0), derivativeCache(nullptr), integralCache(nullptr) // Default constructor (constant 0)
+{
+    POLY_STATS_SCOPE(CONSTRUCT);
+    POLY_STATS_ALLOC(coeffs.size());
+}
 
-Polynomial::Polynomial(const vector<double> &coefficients) : coeffs(coefficients) {} // Initialize with coefficients
+Polynomial::Polynomial(const vector<double> &coefficients) : coeffs(coefficients), derivativeCache(nullptr), integralCache(nullptr) // Initialize with coefficients
+{
+    POLY_STATS_SCOPE(CONSTRUCT);
+    POLY_STATS_ALLOC(coeffs.size());
+}
 
-Polynomial::Polynomial(const Polynomial &other) : coeffs(other.coeffs) {} // Copy constructor
+Polynomial::Polynomial(const Polynomial &other) : coeffs(other.coeffs), derivativeCache(nullptr), integralCache(nullptr) // Copy constructor
+{
+    POLY_STATS_SCOPE(COPY);
+    POLY_STATS_ALLOC(coeffs.size());
+}
 
 // Destructor
-Polynomial::~Polynomial() {}
+Polynomial::~Polynomial()
+{
+    clearCaches();
+}
 
 // Assignment operator
 Polynomial &Polynomial::operator=(const Polynomial &other)
 {
+    POLY_STATS_SCOPE(ASSIGN);
     if (this != &other)
     {
         coeffs = other.coeffs;
+        POLY_STATS_ALLOC(coeffs.size());
+        clearCaches();
     }
     return *this;
 }
@@ -23,152 +47,243 @@ Polynomial &Polynomial::operator=(const Polynomial &other)
 // Arithmetic operators
 Polynomial Polynomial::operator+(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(ADD);
     vector<double> result(max(coeffs.size(), other.coeffs.size()), 0.0);
-    for (size_t i = 0; i < result.size(); ++i)
-    {
-        if (i < coeffs.size())
-            result[i] += coeffs[i];
-        if (i < other.coeffs.size())
-            result[i] += other.coeffs[i];
-    }
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::add(*this, other, result);
     return Polynomial(result);
 }
 
 Polynomial Polynomial::operator-(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(SUBTRACT);
     vector<double> result(max(coeffs.size(), other.coeffs.size()), 0.0);
-    for (size_t i = 0; i < result.size(); ++i)
-    {
-        if (i < coeffs.size())
-            result[i] += coeffs[i];
-        if (i < other.coeffs.size())
-            result[i] -= other.coeffs[i];
-    }
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::subtract(*this, other, result);
     return Polynomial(result);
 }
 
 Polynomial Polynomial::operator*(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(MULTIPLY);
+    POLY_TRACE_SPAN("multiply", "lhs_degree", degree(), "rhs_degree", other.degree());
     vector<double> result(coeffs.size() + other.coeffs.size() - 1, 0.0);
-    for (size_t i = 0; i < coeffs.size(); ++i)
-    {
-        for (size_t j = 0; j < other.coeffs.size(); ++j)
-        {
-            result[i + j] += coeffs[i] * other.coeffs[j];
-        }
-    }
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::multiply(*this, other, result);
     return Polynomial(result);
 }
 
 // Equality operator
 bool Polynomial::operator==(const Polynomial &other) const
 {
+    POLY_STATS_SCOPE(EQUALS);
     return coeffs == other.coeffs;
 }
 
-// Output operator (friend)
-ostream &operator<<(ostream &out, const Polynomial &poly)
+bool Polynomial::equals(const Polynomial &other, double tolerance) const
 {
-    for (int i = poly.coeffs.size() - 1; i >= 0; --i)
+    POLY_STATS_SCOPE(EQUALS);
+    size_t n = max(coeffs.size(), other.coeffs.size());
+    for (size_t i = 0; i < n; ++i)
     {
-        if (poly.coeffs[i] != 0)
-        {
-            if (i != poly.coeffs.size() - 1 && poly.coeffs[i] > 0)
-                out << " + ";
-            else if (poly.coeffs[i] < 0)
-                out << " - ";
-
-            out << abs(poly.coeffs[i]);
-            if (i > 0)
-                out << "x";
-            if (i > 1)
-                out << "^" << i;
-        }
+        double a = i < coeffs.size() ? coeffs[i] : 0.0;
+        double b = i < other.coeffs.size() ? other.coeffs[i] : 0.0;
+        if (!(fabs(a - b) <= tolerance))
+            return false;
     }
-    return out;
+    return true;
+}
+
+size_t Polynomial::hash() const
+{
+    POLY_STATS_SCOPE(HASH);
+    // FNV-1a over the coefficient bits, skipping trailing zeros so that
+    // polynomials equal under == or equals() at tolerance 0 hash the same.
+    // Polynomials within a positive tolerance usually hash differently.
+    size_t n = coeffs.size();
+    while (n > 0 && coeffs[n - 1] == 0)
+        --n;
+
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double c = coeffs[i] == 0 ? 0.0 : coeffs[i]; // Fold -0.0 into 0.0
+        uint64_t bits;
+        memcpy(&bits, &c, sizeof(bits));
+        h = (h ^ bits) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+// Output operator (friend)
+ostream &operator<<(ostream &out, const Polynomial &poly)
+{
+    POLY_STATS_SCOPE(OUTPUT);
+    PolynomialFormat fmt;
+    fmt.style = PolynomialFormat::SPACED;
+    return PolynomialFormatter::write(out, poly, fmt);
+}
+
+// Conversion to a non-owning view
+Polynomial::operator PolynomialView() const
+{
+    return PolynomialView(span<const double>(coeffs));
 }
 
 // Utility functions
 int Polynomial::degree() const
 {
+    POLY_STATS_SCOPE(DEGREE);
     return coeffs.size() - 1;
 }
 
 double Polynomial::evaluate(double x) const
 {
-    double result = 0.0;
-    for (int i = coeffs.size() - 1; i >= 0; --i)
+    POLY_STATS_SCOPE(EVALUATE);
+    return PolynomialView(*this).evaluate(x);
+}
+
+double Polynomial::evaluateAccurate(double x, double *errorBound) const
+{
+    POLY_STATS_SCOPE(EVALUATE_ACCURATE);
+    return PolynomialView(*this).evaluateAccurate(x, errorBound);
+}
+
+void Polynomial::evaluateAccurate(const double *xs, double *out, size_t n, double *errorBounds) const
+{
+    POLY_STATS_SCOPE(EVALUATE_ACCURATE);
+    PolynomialView(*this).evaluateAccurate(xs, out, n, errorBounds);
+}
+
+void Polynomial::evaluateInterval(double lo, double hi, double &outLo, double &outHi) const
+{
+    POLY_STATS_SCOPE(EVALUATE_INTERVAL);
+    PolynomialView(*this).evaluateInterval(lo, hi, outLo, outHi);
+}
+
+void Polynomial::evaluateInterval(const double *los, const double *his, double *outLo, double *outHi, size_t n) const
+{
+    POLY_STATS_SCOPE(EVALUATE_INTERVAL);
+    PolynomialView(*this).evaluateInterval(los, his, outLo, outHi, n);
+}
+
+void Polynomial::evaluateWithDerivatives(double x, int k, double *out) const
+{
+    POLY_STATS_SCOPE(EVALUATE_DERIVATIVES);
+    PolynomialView(*this).evaluateWithDerivatives(x, k, out);
+}
+
+void Polynomial::evaluateWithDerivatives(const double *xs, size_t n, int k, double *out) const
+{
+    POLY_STATS_SCOPE(EVALUATE_DERIVATIVES);
+    for (size_t i = 0; i < n; ++i)
     {
-        result = result * x + coeffs[i];
+        evaluateWithDerivatives(xs[i], k, out + i * (k + 1));
     }
-    return result;
+}
+
+Polynomial::Plan Polynomial::plan() const
+{
+    POLY_STATS_SCOPE(PLAN);
+    return Plan(coeffs);
 }
 
 Polynomial Polynomial::compose(const Polynomial &q) const
 {
-    Polynomial result;
-    Polynomial temp({0.0}); // To store intermediate powers of q
-    for (int i = coeffs.size() - 1; i >= 0; --i)
-    {
-        result = result * q + Polynomial({coeffs[i]});
-    }
-    return result;
+    POLY_STATS_SCOPE(COMPOSE);
+    POLY_TRACE_SPAN("compose", "outer_degree", degree(), "inner_degree", q.degree());
+    if (coeffs.empty()) // Left by setCoefficients({})
+        return Polynomial({0.0});
+    vector<double> result((coeffs.size() - 1) * (max<size_t>(q.coeffs.size(), 1) - 1) + 1);
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::compose(*this, q, result);
+    return Polynomial(result);
 }
 
 Polynomial Polynomial::derivative() const
 {
+    POLY_STATS_SCOPE(DERIVATIVE);
     if (coeffs.size() == 1)
         return Polynomial({0.0});
 
     vector<double> result(coeffs.size() - 1);
-    for (size_t i = 1; i < coeffs.size(); ++i)
-    {
-        result[i - 1] = coeffs[i] * i;
-    }
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::derivative(*this, result);
     return Polynomial(result);
 }
 
 Polynomial Polynomial::integral() const
 {
+    POLY_STATS_SCOPE(INTEGRAL);
     vector<double> result(coeffs.size() + 1, 0.0);
-    for (size_t i = 0; i < coeffs.size(); ++i)
-    {
-        result[i + 1] = coeffs[i] / (i + 1);
-    }
+    POLY_STATS_ALLOC(result.size());
+    PolynomialView::integral(*this, result);
     return Polynomial(result);
 }
 
 double Polynomial::integral(double x1, double x2) const
 {
-    Polynomial integralPoly = integral();
+    POLY_STATS_SCOPE(INTEGRAL_RANGE);
+    const Polynomial &integralPoly = cachedIntegral();
     return integralPoly.evaluate(x2) - integralPoly.evaluate(x1);
 }
 
 double Polynomial::getRoot(double guess, double tolerance, int maxIter)
 {
-    Polynomial deriv = derivative();
-    double x = guess;
-    for (int i = 0; i < maxIter; ++i)
+    POLY_STATS_SCOPE(GET_ROOT);
+    POLY_TRACE_SPAN("getRoot", "degree", degree(), "max_iter", maxIter);
+    return PolynomialView(*this).getRoot(guess, tolerance, maxIter);
+}
+
+// Lazy derivative / antiderivative caches
+const Polynomial &Polynomial::cachedDerivative() const
+{
+    POLY_STATS_SCOPE(CACHED_DERIVATIVE);
+    Polynomial *cached = derivativeCache.load(memory_order_acquire);
+    if (cached == nullptr)
     {
-        double fx = evaluate(x);
-        double dfx = deriv.evaluate(x);
-        if (abs(fx) < tolerance)
-            return x;
-        if (dfx == 0)
-            break; // Avoid division by zero
-        x -= fx / dfx;
+        Polynomial *built = new Polynomial(derivative());
+        if (derivativeCache.compare_exchange_strong(cached, built, memory_order_acq_rel))
+            cached = built;
+        else
+            delete built; // Another reader published first
     }
-    return x; // Return the result after maxIter iterations
+    return *cached;
+}
+
+const Polynomial &Polynomial::cachedIntegral() const
+{
+    POLY_STATS_SCOPE(CACHED_INTEGRAL);
+    Polynomial *cached = integralCache.load(memory_order_acquire);
+    if (cached == nullptr)
+    {
+        Polynomial *built = new Polynomial(integral());
+        if (integralCache.compare_exchange_strong(cached, built, memory_order_acq_rel))
+            cached = built;
+        else
+            delete built;
+    }
+    return *cached;
+}
+
+void Polynomial::clearCaches()
+{
+    delete derivativeCache.exchange(nullptr);
+    delete integralCache.exchange(nullptr);
 }
 
 // Set and Get Coefficients
 void Polynomial::setCoefficients(const vector<double> &coefficients)
 {
+    POLY_STATS_SCOPE(SET_COEFFICIENTS);
     coeffs = coefficients;
+    POLY_STATS_ALLOC(coeffs.size());
+    clearCaches();
 }
 
 double Polynomial::getCoefficient(int degree) const
 {
+    POLY_STATS_SCOPE(GET_COEFFICIENT);
     if (degree < 0 || degree >= coeffs.size())
         return 0.0;
     return coeffs[degree];
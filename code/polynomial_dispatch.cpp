@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "../polynomial_dispatch.h"
+
+// Never fuse multiplies and adds here, whatever the build flags: the variants
+// must round identically (see polynomial_dispatch.h)
+#pragma GCC optimize("fp-contract=off")
+
+namespace polydispatch
+{
+    namespace
+    {
+        // Kernel bodies. They are always inlined into the per-ISA wrappers
+        // below, so each copy is compiled for that wrapper's target.
+        const size_t LANES = 8;
+
+        __attribute__((always_inline)) inline void evaluateBody(const double *coeffs, size_t nc, const double *xs, double *out, size_t n)
+        {
+            // Horner for LANES independent points at once; the lane loop is
+            // what gets vectorized
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                double x[LANES], r[LANES];
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    x[l] = xs[i + l];
+                    r[l] = 0.0;
+                }
+                for (size_t k = nc; k-- > 0;)
+                {
+                    const double c = coeffs[k];
+                    for (size_t l = 0; l < LANES; ++l)
+                    {
+                        r[l] = r[l] * x[l] + c;
+                    }
+                }
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    out[i + l] = r[l];
+                }
+            }
+            for (; i < n; ++i)
+            {
+                double r = 0.0;
+                for (size_t k = nc; k-- > 0;)
+                {
+                    r = r * xs[i] + coeffs[k];
+                }
+                out[i] = r;
+            }
+        }
+
+        __attribute__((always_inline)) inline void multiplyBlockBody(const double *__restrict a, size_t na,
+                                                                     const double *__restrict b, size_t nb,
+                                                                     double *__restrict out, size_t o0, size_t o1)
+        {
+            fill(out + o0, out + o1, 0.0);
+            for (size_t i = 0; i < na && i < o1; ++i)
+            {
+                const double ai = a[i];
+                size_t j = o0 > i ? o0 - i : 0;
+                size_t j1 = min(nb, o1 - i);
+                double *__restrict dst = out + i;
+                for (; j + LANES <= j1; j += LANES)
+                {
+                    for (size_t l = 0; l < LANES; ++l)
+                    {
+                        dst[j + l] += ai * b[j + l];
+                    }
+                }
+                for (; j < j1; ++j)
+                {
+                    dst[j] += ai * b[j];
+                }
+            }
+        }
+
+        template <bool Subtract>
+        __attribute__((always_inline)) inline void addBody(const double *__restrict a, size_t na,
+                                                           const double *__restrict b, size_t nb, double *__restrict out)
+        {
+            size_t common = min(na, nb), i = 0;
+            for (; i + LANES <= common; i += LANES)
+            {
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    out[i + l] = Subtract ? a[i + l] - b[i + l] : a[i + l] + b[i + l];
+                }
+            }
+            for (; i < common; ++i)
+            {
+                out[i] = Subtract ? a[i] - b[i] : a[i] + b[i];
+            }
+            for (i = common; i < na; ++i)
+            {
+                out[i] = a[i];
+            }
+            for (i = common; i < nb; ++i)
+            {
+                out[i] = Subtract ? -b[i] : b[i];
+            }
+        }
+
+        // Error-free transformations: a * b = p + e and a + b = s + e exactly.
+        // With Fma the product error comes from one fused multiply-add,
+        // otherwise from Dekker's splitting.
+        template <bool Fma>
+        __attribute__((always_inline)) inline void twoProduct(double a, double b, double &p, double &e)
+        {
+            p = a * b;
+            if constexpr (Fma)
+            {
+                e = __builtin_fma(a, b, -p);
+            }
+            else
+            {
+                const double SPLIT = 134217729.0; // 2^27 + 1
+                double ca = SPLIT * a, cb = SPLIT * b;
+                double ah = ca - (ca - a), al = a - ah;
+                double bh = cb - (cb - b), bl = b - bh;
+                e = al * bl - (((p - ah * bh) - al * bh) - ah * bl);
+            }
+        }
+
+        __attribute__((always_inline)) inline void twoSum(double a, double b, double &s, double &e)
+        {
+            s = a + b;
+            double z = s - a;
+            e = (a - (s - z)) + (b - z);
+        }
+
+        // Compensated Horner (Graillat, Langlois and Louvet) for L points at
+        // once. The rounding errors of every step are collected in c by a
+        // second Horner pass, and b gathers their magnitudes for the bound.
+        template <bool Fma, size_t L>
+        __attribute__((always_inline)) inline void accurateLanes(const double *coeffs, size_t nc, const double *xs,
+                                                                 double *out, double *bounds)
+        {
+            double x[L], s[L], c[L], b[L];
+            for (size_t l = 0; l < L; ++l)
+            {
+                x[l] = xs[l];
+                s[l] = nc > 0 ? coeffs[nc - 1] : 0.0;
+                c[l] = 0.0;
+                b[l] = 0.0;
+            }
+            for (size_t k = nc - (nc > 0); k-- > 0;)
+            {
+                const double a = coeffs[k];
+                for (size_t l = 0; l < L; ++l)
+                {
+                    double p, pe, se;
+                    twoProduct<Fma>(s[l], x[l], p, pe);
+                    twoSum(p, a, s[l], se);
+                    c[l] = c[l] * x[l] + (pe + se);
+                    b[l] = b[l] * fabs(x[l]) + (fabs(pe) + fabs(se));
+                }
+            }
+
+            // |result - p(x)| <= u |result| + gamma(2n - 1) * exact b; the
+            // computed b and the bound itself are covered by using
+            // gamma(4n + 2) and dividing by 1 - 4u (underflow is ignored)
+            const double u = 0x1p-53;
+            const double n = nc > 1 ? static_cast<double>(nc - 1) : 0.0;
+            const double gamma = (4 * n + 2) * u / (1 - (4 * n + 2) * u);
+            for (size_t l = 0; l < L; ++l)
+            {
+                out[l] = s[l] + c[l];
+                if (bounds)
+                    bounds[l] = (u * fabs(out[l]) + gamma * b[l]) / (1 - 4 * u);
+            }
+        }
+
+        template <bool Fma>
+        __attribute__((always_inline)) inline void evaluateAccurateBody(const double *coeffs, size_t nc, const double *xs,
+                                                                        double *out, double *bounds, size_t n)
+        {
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                accurateLanes<Fma, LANES>(coeffs, nc, xs + i, out + i, bounds ? bounds + i : nullptr);
+            }
+            for (; i < n; ++i)
+            {
+                accurateLanes<Fma, 1>(coeffs, nc, xs + i, out + i, bounds ? bounds + i : nullptr);
+            }
+        }
+
+// One set of wrappers per instruction set
+#define POLY_DISPATCH_VARIANT(suffix, target, fma)                                                                    \
+    target void evaluate##suffix(const double *c, size_t nc, const double *xs, double *out, size_t n)              \
+    {                                                                                                              \
+        evaluateBody(c, nc, xs, out, n);                                                                           \
+    }                                                                                                              \
+    target void multiplyBlock##suffix(const double *a, size_t na, const double *b, size_t nb, double *out,         \
+                                      size_t o0, size_t o1)                                                        \
+    {                                                                                                              \
+        multiplyBlockBody(a, na, b, nb, out, o0, o1);                                                              \
+    }                                                                                                              \
+    target void add##suffix(const double *a, size_t na, const double *b, size_t nb, double *out)                   \
+    {                                                                                                              \
+        addBody<false>(a, na, b, nb, out);                                                                         \
+    }                                                                                                              \
+    target void subtract##suffix(const double *a, size_t na, const double *b, size_t nb, double *out)              \
+    {                                                                                                              \
+        addBody<true>(a, na, b, nb, out);                                                                          \
+    }                                                                                                              \
+    target void evaluateAccurate##suffix(const double *c, size_t nc, const double *xs, double *out, double *bounds, \
+                                         size_t n)                                                                 \
+    {                                                                                                              \
+        evaluateAccurateBody<fma>(c, nc, xs, out, bounds, n);                                                      \
+    }
+
+        POLY_DISPATCH_VARIANT(Scalar, , false)
+#if defined(__x86_64__) || defined(__i386__)
+        POLY_DISPATCH_VARIANT(Sse42, __attribute__((target("sse4.2"))), false)
+        POLY_DISPATCH_VARIANT(Avx2, __attribute__((target("avx2,fma"))), true)
+        POLY_DISPATCH_VARIANT(Avx512, __attribute__((target("avx512f,fma"))), true)
+#define POLY_DISPATCH_X86 1
+#endif
+#undef POLY_DISPATCH_VARIANT
+
+        const Kernels TABLE[ISA_COUNT] = {
+            {evaluateScalar, multiplyBlockScalar, addScalar, subtractScalar, evaluateAccurateScalar},
+#ifdef POLY_DISPATCH_X86
+            {evaluateSse42, multiplyBlockSse42, addSse42, subtractSse42, evaluateAccurateSse42},
+            {evaluateAvx2, multiplyBlockAvx2, addAvx2, subtractAvx2, evaluateAccurateAvx2},
+            {evaluateAvx512, multiplyBlockAvx512, addAvx512, subtractAvx512, evaluateAccurateAvx512},
+#else
+            {evaluateScalar, multiplyBlockScalar, addScalar, subtractScalar, evaluateAccurateScalar},
+            {evaluateScalar, multiplyBlockScalar, addScalar, subtractScalar, evaluateAccurateScalar},
+            {evaluateScalar, multiplyBlockScalar, addScalar, subtractScalar, evaluateAccurateScalar},
+#endif
+        };
+
+        const char *const NAMES[ISA_COUNT] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+        atomic<int> selected{-1};
+
+        Isa best()
+        {
+            for (int i = ISA_COUNT - 1; i > SCALAR; --i)
+            {
+                if (supported(static_cast<Isa>(i)))
+                    return static_cast<Isa>(i);
+            }
+            return SCALAR;
+        }
+
+        int resolve()
+        {
+            Isa choice = best();
+            if (const char *forced = getenv("POLYNOMIAL_ISA"))
+            {
+                for (int i = 0; i < ISA_COUNT; ++i)
+                {
+                    if (strcmp(forced, NAMES[i]) == 0 && supported(static_cast<Isa>(i)))
+                        choice = static_cast<Isa>(i);
+                }
+            }
+            int expected = -1;
+            selected.compare_exchange_strong(expected, choice);
+            return selected.load();
+        }
+
+        // Resolve while the library loads so the first call pays nothing
+        [[maybe_unused]] const int loadTimeChoice = resolve();
+    }
+
+    bool supported(Isa isa)
+    {
+#ifdef POLY_DISPATCH_X86
+        __builtin_cpu_init();
+        switch (isa)
+        {
+        case SSE4_2:
+            return __builtin_cpu_supports("sse4.2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+        default:
+            return isa == SCALAR;
+        }
+#else
+        return isa == SCALAR;
+#endif
+    }
+
+    const Kernels &kernels()
+    {
+        int i = selected.load(memory_order_relaxed);
+        return TABLE[i >= 0 ? i : resolve()];
+    }
+
+    Isa isa()
+    {
+        int i = selected.load(memory_order_relaxed);
+        return static_cast<Isa>(i >= 0 ? i : resolve());
+    }
+
+    const char *name(Isa isa)
+    {
+        return isa < ISA_COUNT ? NAMES[isa] : "unknown";
+    }
+
+    bool setIsa(Isa isa)
+    {
+        if (isa >= ISA_COUNT || !supported(isa))
+            return false;
+        selected.store(isa);
+        return true;
+    }
+}
@@ -0,0 +1,139 @@
+#include <stdexcept>
+#include "../polynomial_fitter.h"
+
+// Constructors
+PolynomialFitter::PolynomialFitter(int maxDegree, double lower, double upper)
+    : n(maxDegree + 1), lower(lower), upper(upper), R(static_cast<size_t>(n) * n, 0.0), qty(n, 0.0),
+      residualSum(0), samples(0), row(n)
+{
+    if (maxDegree < 0)
+        throw invalid_argument("Degree must be non-negative.");
+    if (!(lower < upper))
+        throw invalid_argument("Fitting domain must have lower < upper.");
+}
+
+void PolynomialFitter::rotate(double *r, double rhs)
+{
+    // Givens rotations zero the row against the diagonal of R, column by column
+    for (int k = 0; k < n; ++k)
+    {
+        if (r[k] == 0)
+            continue;
+        double *Rk = &R[static_cast<size_t>(k) * n];
+        double h = hypot(Rk[k], r[k]);
+        double c = Rk[k] / h, s = r[k] / h;
+        Rk[k] = h;
+        for (int j = k + 1; j < n; ++j)
+        {
+            double top = Rk[j];
+            Rk[j] = c * top + s * r[j];
+            r[j] = c * r[j] - s * top;
+        }
+        double top = qty[k];
+        qty[k] = c * top + s * rhs;
+        rhs = c * rhs - s * top;
+    }
+    residualSum += rhs * rhs;
+}
+
+void PolynomialFitter::add(double x, double y, double weight)
+{
+    if (weight < 0)
+        throw invalid_argument("Weight must be non-negative.");
+    if (weight == 0)
+        return;
+
+    // T_0 .. T_(n-1) at t in [-1, 1], scaled by sqrt(weight)
+    double t = (2 * x - lower - upper) / (upper - lower), w = sqrt(weight);
+    row[0] = w;
+    if (n > 1)
+        row[1] = w * t;
+    for (int k = 2; k < n; ++k)
+    {
+        row[k] = 2 * t * row[k - 1] - row[k - 2];
+    }
+    rotate(row.data(), w * y);
+    ++samples;
+}
+
+void PolynomialFitter::add(const double *xs, const double *ys, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        add(xs[i], ys[i]);
+    }
+}
+
+void PolynomialFitter::merge(const PolynomialFitter &other)
+{
+    if (other.n != n || other.lower != lower || other.upper != upper)
+        throw invalid_argument("Fitters must have the same degree and domain.");
+    // The rows of the other factor carry exactly its samples' information
+    for (int k = 0; k < n; ++k)
+    {
+        copy(other.R.begin() + static_cast<size_t>(k) * n, other.R.begin() + static_cast<size_t>(k + 1) * n, row.begin());
+        rotate(row.data(), other.qty[k]);
+    }
+    residualSum += other.residualSum;
+    samples += other.samples;
+}
+
+// Utility functions
+int PolynomialFitter::maxDegree() const
+{
+    return n - 1;
+}
+
+size_t PolynomialFitter::count() const
+{
+    return samples;
+}
+
+Polynomial PolynomialFitter::fit(int degree) const
+{
+    if (degree < 0 || degree >= n)
+        throw out_of_range("Degree must be between 0 and maxDegree.");
+
+    // Back substitution on the leading block gives Chebyshev coefficients
+    int m = degree + 1;
+    vector<double> c(m);
+    for (int k = m - 1; k >= 0; --k)
+    {
+        const double *Rk = &R[static_cast<size_t>(k) * n];
+        if (fabs(Rk[k]) <= 1e-13 * fabs(R[0]))
+            throw runtime_error("Not enough samples to determine the fit.");
+        double sum = qty[k];
+        for (int j = k + 1; j < m; ++j)
+        {
+            sum -= Rk[j] * c[j];
+        }
+        c[k] = sum / Rk[k];
+    }
+
+    // Sum of c_k T_k(t) with t = (2x - lower - upper) / (upper - lower)
+    Polynomial t({-(lower + upper) / (upper - lower), 2 / (upper - lower)});
+    Polynomial twoT = t * Polynomial({2});
+    Polynomial previous({1}), current = t;
+    Polynomial result({c[0]});
+    for (int k = 1; k < m; ++k)
+    {
+        result = result + current * Polynomial({c[k]});
+        Polynomial next = twoT * current - previous;
+        previous = current;
+        current = next;
+    }
+    return result;
+}
+
+double PolynomialFitter::residual(int degree) const
+{
+    if (degree < 0 || degree >= n)
+        throw out_of_range("Degree must be between 0 and maxDegree.");
+    // Components of Q^T y beyond the fitted columns are left unexplained
+    double result = residualSum;
+    for (int k = degree + 1; k < n; ++k)
+    {
+        result += qty[k] * qty[k];
+    }
+    return result;
+}
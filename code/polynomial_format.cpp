@@ -0,0 +1,99 @@
+#include <charconv>
+#include <cstring>
+#include "../polynomial_format.h"
+
+namespace
+{
+    // Longest term: sign and separator, a number with up to MAX_PRECISION
+    // digits plus exponent, and "x^" with a 64-bit power
+    const int MAX_PRECISION = 40;
+    const size_t TERM_BUFFER = 128;
+
+    size_t writeNumber(char *p, double value, int precision)
+    {
+        to_chars_result result = precision < 0
+                                     ? to_chars(p, p + 64, value)
+                                     : to_chars(p, p + 64, value, chars_format::general, min(max(precision, 1), MAX_PRECISION));
+        return result.ptr - p;
+    }
+
+    // Calls sink(text, length) once per term
+    template <typename Sink>
+    void writeTerms(PolynomialView poly, const PolynomialFormat &fmt, Sink &&sink)
+    {
+        char term[TERM_BUFFER];
+        bool first = true;
+        int n = poly.degree();
+        for (int k = 0; k <= n; ++k)
+        {
+            int i = fmt.ascending ? k : n - k;
+            double c = poly.getCoefficient(i);
+            if (c == 0)
+                continue;
+
+            char *p = term;
+            if (fmt.style == PolynomialFormat::SPACED)
+            {
+                if (first)
+                {
+                    if (c < 0)
+                        *p++ = '-';
+                }
+                else
+                {
+                    memcpy(p, c < 0 ? " - " : " + ", 3);
+                    p += 3;
+                }
+                p += writeNumber(p, fabs(c), fmt.precision);
+                if (i > 0)
+                    *p++ = 'x';
+                if (i > 1)
+                {
+                    *p++ = '^';
+                    p = to_chars(p, term + TERM_BUFFER, i).ptr;
+                }
+            }
+            else
+            {
+                if (!first && c > 0)
+                    *p++ = '+';
+                p += writeNumber(p, c, fmt.precision);
+                if (i > 0)
+                {
+                    memcpy(p, "x^", 2);
+                    p = to_chars(p + 2, term + TERM_BUFFER, i).ptr;
+                }
+            }
+            sink(term, p - term);
+            first = false;
+        }
+        if (first)
+            sink("0", 1);
+    }
+}
+
+size_t PolynomialFormatter::format(PolynomialView poly, char *buf, size_t size, const PolynomialFormat &fmt)
+{
+    size_t length = 0;
+    writeTerms(poly, fmt, [&](const char *text, size_t n)
+               {
+        if (length < size)
+            memcpy(buf + length, text, min(n, size - length));
+        length += n; });
+    if (size > 0)
+        buf[min(length, size - 1)] = '\0';
+    return length;
+}
+
+void PolynomialFormatter::appendTo(string &out, PolynomialView poly, const PolynomialFormat &fmt)
+{
+    writeTerms(poly, fmt, [&](const char *text, size_t n)
+               { out.append(text, n); });
+}
+
+ostream &PolynomialFormatter::write(ostream &out, PolynomialView poly, const PolynomialFormat &fmt)
+{
+    writeTerms(poly, fmt, [&](const char *text, size_t n)
+               { out.write(text, n); });
+    return out;
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cmath>
+#include "../polynomial_view.h"
+
+// Range enclosures of p over [lo, hi]
+//
+// Every operation rounds to nearest and then steps outward by at least one
+// ulp, which has the effect of directed rounding without switching the FPU
+// mode. The range is enclosed three ways and the results are intersected:
+//   - natural extension: Horner in interval arithmetic
+//   - mean-value form: p(m) + p'([lo, hi]) ([lo, hi] - m), m the midpoint
+//   - Bernstein bound: p rewritten over [lo, hi] in the Bernstein basis; the
+//     range lies between the smallest and largest Bernstein coefficient
+// The first two are evaluated for eight intervals at a time. The Bernstein
+// step costs O(n^2) per interval and is used up to MAX_BERNSTEIN_DEGREE,
+// where the binomial coefficients are still exact doubles.
+
+namespace
+{
+    const int MAX_BERNSTEIN_DEGREE = 50;
+    const size_t LANES = 8;
+
+    inline double down(double r)
+    {
+        return r - fabs(r) * 0x1p-52 - 0x1p-1074;
+    }
+
+    inline double up(double r)
+    {
+        return r + fabs(r) * 0x1p-52 + 0x1p-1074;
+    }
+
+    struct Range
+    {
+        double lo, hi;
+    };
+
+    inline Range add(Range a, Range b)
+    {
+        return {down(a.lo + b.lo), up(a.hi + b.hi)};
+    }
+
+    inline Range mul(Range a, Range b)
+    {
+        double p1 = a.lo * b.lo, p2 = a.lo * b.hi, p3 = a.hi * b.lo, p4 = a.hi * b.hi;
+        return {down(min(min(p1, p2), min(p3, p4))), up(max(max(p1, p2), max(p3, p4)))};
+    }
+
+    inline Range point(double v)
+    {
+        return {v, v};
+    }
+
+    // Interval Horner for L intervals; coefficient k is [cLo[k], cHi[k]]
+    template <size_t L>
+    inline void horner(const double *cLo, const double *cHi, size_t nc, const Range *x, Range *out)
+    {
+        for (size_t l = 0; l < L; ++l)
+        {
+            out[l] = nc > 0 ? Range{cLo[nc - 1], cHi[nc - 1]} : point(0.0);
+        }
+        for (size_t k = nc - (nc > 0); k-- > 0;)
+        {
+            const Range c{cLo[k], cHi[k]};
+            for (size_t l = 0; l < L; ++l)
+            {
+                out[l] = add(mul(out[l], x[l]), c);
+            }
+        }
+    }
+
+    // Natural extension intersected with the mean-value form for L intervals
+    template <size_t L>
+    inline void enclose(span<const double> coeffs, const vector<double> &dLo, const vector<double> &dHi,
+                        const double *los, const double *his, double *outLo, double *outHi)
+    {
+        Range x[L], mid[L], natural[L], atMid[L], slope[L];
+        for (size_t l = 0; l < L; ++l)
+        {
+            x[l] = {los[l], his[l]};
+            mid[l] = point(los[l] + (his[l] - los[l]) / 2);
+        }
+        horner<L>(coeffs.data(), coeffs.data(), coeffs.size(), x, natural);
+        horner<L>(coeffs.data(), coeffs.data(), coeffs.size(), mid, atMid);
+        horner<L>(dLo.data(), dHi.data(), dLo.size(), x, slope);
+        for (size_t l = 0; l < L; ++l)
+        {
+            Range offset{down(x[l].lo - mid[l].lo), up(x[l].hi - mid[l].lo)};
+            Range centered = add(atMid[l], mul(slope[l], offset));
+            outLo[l] = max(natural[l].lo, centered.lo);
+            outHi[l] = min(natural[l].hi, centered.hi);
+        }
+    }
+
+    Range bernstein(span<const double> coeffs, double lo, double hi)
+    {
+        const int n = static_cast<int>(coeffs.size()) - 1;
+        vector<Range> a(coeffs.size());
+        for (int k = 0; k <= n; ++k)
+        {
+            a[k] = point(coeffs[k]);
+        }
+
+        // Taylor shift to t = x - lo, then scale to t in [0, 1]
+        const Range shift = point(lo);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int k = n - 1; k >= i; --k)
+            {
+                a[k] = add(a[k], mul(shift, a[k + 1]));
+            }
+        }
+        const Range width{down(hi - lo), up(hi - lo)};
+        Range power = point(1.0);
+        for (int j = 0; j <= n; ++j)
+        {
+            a[j] = mul(a[j], power);
+            power = mul(power, width);
+        }
+
+        // b_i = sum over j <= i of C(i, j) / C(n, j) a_j
+        vector<double> binomN(n + 1, 1.0), binomI(n + 1, 1.0);
+        for (int j = 1; j <= n; ++j)
+        {
+            binomN[j] = binomN[j - 1] * (n - j + 1) / j; // Exact while below 2^53
+        }
+        Range result{HUGE_VAL, -HUGE_VAL};
+        for (int i = 0; i <= n; ++i)
+        {
+            // Row i of Pascal's triangle
+            for (int j = i; j > 0; --j)
+            {
+                binomI[j] = j == i ? 1.0 : binomI[j] + binomI[j - 1];
+            }
+            Range b = point(0.0);
+            for (int j = 0; j <= i; ++j)
+            {
+                Range ratio{down(binomI[j] / binomN[j]), up(binomI[j] / binomN[j])};
+                b = add(b, mul(ratio, a[j]));
+            }
+            result.lo = min(result.lo, b.lo);
+            result.hi = max(result.hi, b.hi);
+        }
+        return result;
+    }
+}
+
+void PolynomialView::evaluateInterval(double lo, double hi, double &outLo, double &outHi) const
+{
+    evaluateInterval(&lo, &hi, &outLo, &outHi, 1);
+}
+
+void PolynomialView::evaluateInterval(const double *los, const double *his, double *outLo, double *outHi, size_t n) const
+{
+    // Derivative coefficients as intervals, since k * c_k may round
+    vector<double> dLo, dHi;
+    for (size_t k = 1; k < coeffs.size(); ++k)
+    {
+        double d = coeffs[k] * static_cast<double>(k);
+        dLo.push_back(down(d));
+        dHi.push_back(up(d));
+    }
+
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        enclose<LANES>(coeffs, dLo, dHi, los + i, his + i, outLo + i, outHi + i);
+    }
+    for (; i < n; ++i)
+    {
+        enclose<1>(coeffs, dLo, dHi, los + i, his + i, outLo + i, outHi + i);
+    }
+
+    if (degree() >= 1 && degree() <= MAX_BERNSTEIN_DEGREE)
+    {
+        for (i = 0; i < n; ++i)
+        {
+            Range b = bernstein(coeffs, los[i], his[i]);
+            outLo[i] = max(outLo[i], b.lo);
+            outHi[i] = min(outHi[i], b.hi);
+        }
+    }
+}
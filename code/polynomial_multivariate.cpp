@@ -0,0 +1,623 @@
+#include <map>
+#include <stdexcept>
+#include "../polynomial_multivariate.h"
+#include "../polynomial_tasks.h"
+#include "../polynomial_view.h"
+
+namespace
+{
+    const uint64_t EMPTY = ~0ull; // Never a valid key: every exponent byte exceeds MAX_EXPONENT
+
+    int shift(int variable)
+    {
+        return 8 * (MultivariatePolynomial::MAX_VARIABLES - 1 - variable);
+    }
+
+    int exponentOf(uint64_t key, int variable)
+    {
+        return static_cast<int>((key >> shift(variable)) & 0xFF);
+    }
+
+    double power(double x, int e)
+    {
+        double result = 1;
+        while (e > 0)
+        {
+            if (e & 1)
+                result *= x;
+            x *= x;
+            e >>= 1;
+        }
+        return result;
+    }
+
+    // Open-addressing hash map from key to a running sum. Each key is summed
+    // in the order its contributions arrive, so results do not depend on the
+    // table size.
+    class Accumulator
+    {
+    private:
+        vector<uint64_t> keys;
+        vector<double> values;
+        size_t mask, count = 0;
+
+        size_t slot(uint64_t key) const
+        {
+            return (key * 0x9E3779B97F4A7C15ull >> 20) & mask;
+        }
+
+        void grow()
+        {
+            vector<uint64_t> oldKeys = move(keys);
+            vector<double> oldValues = move(values);
+            keys.assign(oldKeys.size() * 2, EMPTY);
+            values.assign(oldKeys.size() * 2, 0.0);
+            mask = keys.size() - 1;
+            for (size_t i = 0; i < oldKeys.size(); ++i)
+            {
+                if (oldKeys[i] == EMPTY)
+                    continue;
+                size_t s = slot(oldKeys[i]);
+                while (keys[s] != EMPTY)
+                    s = (s + 1) & mask;
+                keys[s] = oldKeys[i];
+                values[s] = oldValues[i];
+            }
+        }
+
+    public:
+        explicit Accumulator(size_t expected)
+        {
+            size_t capacity = 16;
+            while (capacity < 2 * expected)
+                capacity *= 2;
+            keys.assign(capacity, EMPTY);
+            values.assign(capacity, 0.0);
+            mask = capacity - 1;
+        }
+
+        void add(uint64_t key, double value)
+        {
+            size_t s = slot(key);
+            while (keys[s] != EMPTY && keys[s] != key)
+                s = (s + 1) & mask;
+            if (keys[s] == EMPTY)
+            {
+                keys[s] = key;
+                if (2 * ++count > keys.size())
+                {
+                    // Rehash, then add into the new table
+                    values[s] = 0;
+                    grow();
+                    s = slot(key);
+                    while (keys[s] != key)
+                        s = (s + 1) & mask;
+                }
+            }
+            values[s] += value;
+        }
+
+        // Nonzero entries in ascending key order
+        void extract(vector<pair<uint64_t, double>> &out) const
+        {
+            out.clear();
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                if (keys[i] != EMPTY && values[i] != 0)
+                    out.push_back({keys[i], values[i]});
+            }
+            sort(out.begin(), out.end());
+        }
+    };
+}
+
+// Constructors
+MultivariatePolynomial::MultivariatePolynomial() : MultivariatePolynomial(1) {}
+
+MultivariatePolynomial::MultivariatePolynomial(int variables) : vars(variables)
+{
+    if (variables < 1 || variables > MAX_VARIABLES)
+        throw invalid_argument("Number of variables must be between 1 and MAX_VARIABLES.");
+}
+
+MultivariatePolynomial::MultivariatePolynomial(int variables, const vector<pair<vector<int>, double>> &terms)
+    : MultivariatePolynomial(variables)
+{
+    vector<pair<uint64_t, double>> packed;
+    packed.reserve(terms.size());
+    for (const auto &[exponents, c] : terms)
+    {
+        if (static_cast<int>(exponents.size()) != variables)
+            throw invalid_argument("Every term needs one exponent per variable.");
+        uint64_t key = 0;
+        for (int v = 0; v < variables; ++v)
+        {
+            if (exponents[v] < 0 || exponents[v] > MAX_EXPONENT)
+                throw out_of_range("Exponent must be between 0 and MAX_EXPONENT.");
+            key |= static_cast<uint64_t>(exponents[v]) << shift(v);
+        }
+        packed.push_back({key, c});
+    }
+    *this = fromUnsorted(variables, packed);
+}
+
+MultivariatePolynomial MultivariatePolynomial::constant(int variables, double value)
+{
+    MultivariatePolynomial result(variables);
+    if (value != 0)
+    {
+        result.keys.push_back(0);
+        result.coeffs.push_back(value);
+    }
+    return result;
+}
+
+MultivariatePolynomial MultivariatePolynomial::variable(int variables, int index)
+{
+    MultivariatePolynomial result(variables);
+    if (index < 0 || index >= variables)
+        throw out_of_range("Variable index out of range.");
+    result.keys.push_back(unit(index));
+    result.coeffs.push_back(1);
+    return result;
+}
+
+uint64_t MultivariatePolynomial::unit(int variable)
+{
+    return 1ull << shift(variable);
+}
+
+MultivariatePolynomial MultivariatePolynomial::fromUnsorted(int variables, vector<pair<uint64_t, double>> &terms)
+{
+    // Stable so equal keys are summed in the order given
+    stable_sort(terms.begin(), terms.end(), [](const auto &x, const auto &y)
+                { return x.first < y.first; });
+    MultivariatePolynomial result(variables);
+    for (size_t i = 0; i < terms.size();)
+    {
+        uint64_t key = terms[i].first;
+        double sum = 0;
+        for (; i < terms.size() && terms[i].first == key; ++i)
+        {
+            sum += terms[i].second;
+        }
+        if (sum != 0)
+        {
+            result.keys.push_back(key);
+            result.coeffs.push_back(sum);
+        }
+    }
+    return result;
+}
+
+// Arithmetic operators
+MultivariatePolynomial MultivariatePolynomial::operator+(const MultivariatePolynomial &other) const
+{
+    if (vars != other.vars)
+        throw invalid_argument("Polynomials must have the same number of variables.");
+    // Merge of the two sorted term arrays
+    MultivariatePolynomial result(vars);
+    result.keys.reserve(keys.size() + other.keys.size());
+    result.coeffs.reserve(keys.size() + other.keys.size());
+    size_t i = 0, j = 0;
+    while (i < keys.size() || j < other.keys.size())
+    {
+        uint64_t key;
+        double c;
+        if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j]))
+        {
+            key = keys[i];
+            c = coeffs[i++];
+        }
+        else if (i == keys.size() || other.keys[j] < keys[i])
+        {
+            key = other.keys[j];
+            c = other.coeffs[j++];
+        }
+        else
+        {
+            key = keys[i];
+            c = coeffs[i++] + other.coeffs[j++];
+        }
+        if (c != 0)
+        {
+            result.keys.push_back(key);
+            result.coeffs.push_back(c);
+        }
+    }
+    return result;
+}
+
+MultivariatePolynomial MultivariatePolynomial::operator-(const MultivariatePolynomial &other) const
+{
+    MultivariatePolynomial negated = other;
+    for (double &c : negated.coeffs)
+    {
+        c = -c;
+    }
+    return *this + negated;
+}
+
+MultivariatePolynomial MultivariatePolynomial::operator*(const MultivariatePolynomial &other) const
+{
+    if (vars != other.vars)
+        throw invalid_argument("Polynomials must have the same number of variables.");
+    MultivariatePolynomial result(vars);
+    if (keys.empty() || other.keys.empty())
+        return result;
+    for (int v = 0; v < vars; ++v)
+    {
+        if (degree(v) + other.degree(v) > MAX_EXPONENT)
+            throw overflow_error("Product exponent exceeds MAX_EXPONENT.");
+    }
+
+    // Keys add without carries, so for a fixed left term the right terms whose
+    // product falls in [lo, hi) form one contiguous run. The output key range
+    // is cut into chunks at quantiles of a sample of product keys and each
+    // chunk is accumulated by its own task; a key lives in exactly one chunk
+    // and is always summed in the same order, whatever the chunk count.
+    const vector<uint64_t> &a = keys, &b = other.keys;
+    size_t work = a.size() * b.size();
+    // Products below the grain, or with a single worker, stay in one chunk on the caller
+    size_t chunks = 1;
+    if (polytasks::workerCount() > 1)
+        chunks = min<size_t>(max<size_t>(work / polytasks::effectiveGrain(work), 1), 256);
+
+    vector<uint64_t> bounds{0};
+    if (chunks > 1)
+    {
+        vector<uint64_t> sample;
+        size_t si = min<size_t>(a.size(), 64), sj = min<size_t>(b.size(), 64);
+        for (size_t i = 0; i < si; ++i)
+        {
+            for (size_t j = 0; j < sj; ++j)
+            {
+                sample.push_back(a[i * a.size() / si] + b[j * b.size() / sj]);
+            }
+        }
+        sort(sample.begin(), sample.end());
+        for (size_t c = 1; c < chunks; ++c)
+        {
+            uint64_t bound = sample[c * sample.size() / chunks];
+            if (bound > bounds.back())
+                bounds.push_back(bound);
+        }
+    }
+    bounds.push_back(EMPTY);
+
+    size_t parts = bounds.size() - 1;
+    vector<vector<pair<uint64_t, double>>> outputs(parts);
+    auto accumulate = [&](size_t part)
+    {
+        uint64_t lo = bounds[part], hi = bounds[part + 1];
+        Accumulator sums(min(work / parts, a.size() + b.size()));
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (hi <= a[i])
+                break;
+            auto first = lo > a[i] ? lower_bound(b.begin(), b.end(), lo - a[i]) : b.begin();
+            auto last = lower_bound(first, b.end(), hi - a[i]);
+            for (auto it = first; it != last; ++it)
+            {
+                sums.add(a[i] + *it, coeffs[i] * other.coeffs[it - b.begin()]);
+            }
+        }
+        sums.extract(outputs[part]);
+    };
+
+    if (parts == 1)
+        accumulate(0);
+    else
+    {
+        polytasks::TaskGroup group;
+        for (size_t part = 1; part < parts; ++part)
+        {
+            group.spawn([&accumulate, part]()
+                        { accumulate(part); });
+        }
+        accumulate(0);
+        group.sync();
+    }
+
+    for (const auto &output : outputs)
+    {
+        for (const auto &[key, c] : output)
+        {
+            result.keys.push_back(key);
+            result.coeffs.push_back(c);
+        }
+    }
+    return result;
+}
+
+// Equality operator
+bool MultivariatePolynomial::operator==(const MultivariatePolynomial &other) const
+{
+    return vars == other.vars && keys == other.keys && coeffs == other.coeffs;
+}
+
+// Output operator (friend)
+ostream &operator<<(ostream &out, const MultivariatePolynomial &p)
+{
+    if (p.keys.empty())
+        return out << "0";
+    for (size_t i = p.keys.size(); i-- > 0;)
+    {
+        double c = p.coeffs[i];
+        if (i + 1 == p.keys.size())
+            out << (c < 0 ? "-" : "");
+        else
+            out << (c < 0 ? " - " : " + ");
+        out << fabs(c);
+        bool first = true;
+        for (int v = 0; v < p.vars; ++v)
+        {
+            int e = exponentOf(p.keys[i], v);
+            if (e == 0)
+                continue;
+            out << (first ? "" : "*") << "x" << v;
+            if (e > 1)
+                out << "^" << e;
+            first = false;
+        }
+    }
+    return out;
+}
+
+// Utility functions
+int MultivariatePolynomial::variables() const
+{
+    return vars;
+}
+
+size_t MultivariatePolynomial::terms() const
+{
+    return keys.size();
+}
+
+int MultivariatePolynomial::exponent(size_t term, int variable) const
+{
+    if (term >= keys.size() || variable < 0 || variable >= vars)
+        throw out_of_range("Term or variable index out of range.");
+    return exponentOf(keys[term], variable);
+}
+
+double MultivariatePolynomial::coefficient(size_t term) const
+{
+    if (term >= keys.size())
+        throw out_of_range("Term index out of range.");
+    return coeffs[term];
+}
+
+double MultivariatePolynomial::coefficient(const vector<int> &exponents) const
+{
+    if (static_cast<int>(exponents.size()) != vars)
+        throw invalid_argument("Expected one exponent per variable.");
+    uint64_t key = 0;
+    for (int v = 0; v < vars; ++v)
+    {
+        if (exponents[v] < 0 || exponents[v] > MAX_EXPONENT)
+            return 0;
+        key |= static_cast<uint64_t>(exponents[v]) << shift(v);
+    }
+    auto it = lower_bound(keys.begin(), keys.end(), key);
+    return it != keys.end() && *it == key ? coeffs[it - keys.begin()] : 0;
+}
+
+int MultivariatePolynomial::degree() const
+{
+    int result = -1;
+    for (uint64_t key : keys)
+    {
+        int total = 0;
+        for (int v = 0; v < vars; ++v)
+        {
+            total += exponentOf(key, v);
+        }
+        result = max(result, total);
+    }
+    return result;
+}
+
+int MultivariatePolynomial::degree(int variable) const
+{
+    if (variable < 0 || variable >= vars)
+        throw out_of_range("Variable index out of range.");
+    int result = -1;
+    for (uint64_t key : keys)
+    {
+        result = max(result, exponentOf(key, variable));
+    }
+    return result;
+}
+
+double MultivariatePolynomial::evaluate(const double *x) const
+{
+    double result = 0;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        double term = coeffs[i];
+        for (int v = 0; v < vars; ++v)
+        {
+            term *= power(x[v], exponentOf(keys[i], v));
+        }
+        result += term;
+    }
+    return result;
+}
+
+MultivariatePolynomial::Plan MultivariatePolynomial::plan() const
+{
+    return Plan(*this);
+}
+
+MultivariatePolynomial MultivariatePolynomial::derivative(int variable) const
+{
+    if (variable < 0 || variable >= vars)
+        throw out_of_range("Variable index out of range.");
+    // Lowering one exponent by the same amount keeps the keys in order
+    MultivariatePolynomial result(vars);
+    uint64_t step = unit(variable);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        int e = exponentOf(keys[i], variable);
+        if (e == 0)
+            continue;
+        result.keys.push_back(keys[i] - step);
+        result.coeffs.push_back(coeffs[i] * e);
+    }
+    return result;
+}
+
+MultivariatePolynomial MultivariatePolynomial::substitute(int variable, const Polynomial &q, int into) const
+{
+    if (into < 0)
+        into = variable;
+    if (variable < 0 || variable >= vars || into >= vars)
+        throw out_of_range("Variable index out of range.");
+
+    // Powers q^0 .. q^e for the highest exponent of the replaced variable
+    span<const double> qc = PolynomialView(q).coefficients();
+    vector<double> base(qc.begin(), qc.end());
+    while (base.size() > 1 && base.back() == 0)
+        base.pop_back();
+    if (base.empty())
+        base.push_back(0);
+    int maxE = max(degree(variable), 0);
+    vector<vector<double>> powers{{1}};
+    for (int e = 1; e <= maxE; ++e)
+    {
+        vector<double> next(powers.back().size() + base.size() - 1);
+        PolynomialView::multiply(span<const double>(powers.back()), span<const double>(base), next);
+        powers.push_back(move(next));
+    }
+
+    uint64_t mask = ~(0xFFull << shift(variable));
+    vector<pair<uint64_t, double>> expanded;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const vector<double> &qe = powers[exponentOf(keys[i], variable)];
+        uint64_t rest = keys[i] & mask;
+        if (exponentOf(rest, into) + static_cast<int>(qe.size()) - 1 > MAX_EXPONENT)
+            throw overflow_error("Substituted exponent exceeds MAX_EXPONENT.");
+        for (size_t k = 0; k < qe.size(); ++k)
+        {
+            if (qe[k] != 0)
+                expanded.push_back({rest + k * unit(into), coeffs[i] * qe[k]});
+        }
+    }
+    return fromUnsorted(vars, expanded);
+}
+
+// Evaluation plan
+MultivariatePolynomial::Plan::Plan() : vars(1), steps{{Step::CONST, 0, 0, 0.0}} {}
+
+MultivariatePolynomial::Plan::Plan(const MultivariatePolynomial &p) : vars(p.vars)
+{
+    const vector<uint64_t> &keys = p.keys;
+    if (keys.empty())
+    {
+        steps.push_back({Step::CONST, 0, 0, 0.0});
+        return;
+    }
+
+    // Horner in variable v over the terms [lo, hi), which share exponents of
+    // x0..x(v-1). Groups with equal exponent of v are coefficients, built
+    // recursively one register higher. Slots hold (variable << 8 | exponent)
+    // until they are renumbered below.
+    auto compile = [&](auto &self, size_t lo, size_t hi, int v, uint8_t reg) -> void
+    {
+        if (v == vars)
+        {
+            steps.push_back({Step::CONST, reg, 0, p.coeffs[lo]});
+            return;
+        }
+        int previous = -1;
+        for (size_t end = hi; end > lo;)
+        {
+            int e = exponentOf(keys[end - 1], v);
+            size_t start = end - 1;
+            while (start > lo && exponentOf(keys[start - 1], v) == e)
+                --start;
+            if (previous < 0)
+                self(self, start, end, v + 1, reg);
+            else
+            {
+                self(self, start, end, v + 1, reg + 1);
+                steps.push_back({Step::HORNER, reg, static_cast<uint32_t>(v << 8 | (previous - e)), 0.0});
+            }
+            previous = e;
+            end = start;
+        }
+        if (previous > 0)
+            steps.push_back({Step::SCALE, reg, static_cast<uint32_t>(v << 8 | previous), 0.0});
+    };
+    compile(compile, 0, keys.size(), 0, 0);
+
+    // Renumber the slots densely, sorted by variable then exponent
+    map<uint32_t, uint32_t> slots;
+    for (const Step &s : steps)
+    {
+        if (s.op != Step::CONST)
+            slots[s.slot] = 0;
+    }
+    for (auto &[code, index] : slots)
+    {
+        index = static_cast<uint32_t>(powers.size());
+        powers.push_back({code >> 8, code & 0xFF});
+    }
+    for (Step &s : steps)
+    {
+        if (s.op != Step::CONST)
+            s.slot = slots[s.slot];
+    }
+}
+
+int MultivariatePolynomial::Plan::variables() const
+{
+    return vars;
+}
+
+double MultivariatePolynomial::Plan::evaluate(const double *x) const
+{
+    double result;
+    evaluate(x, &result, 1);
+    return result;
+}
+
+void MultivariatePolynomial::Plan::evaluate(const double *points, double *out, size_t n) const
+{
+    // Registers and powers live on the stack unless there are many distinct powers
+    double reg[MAX_VARIABLES + 1], local[64];
+    vector<double> spill(powers.size() > 64 ? powers.size() : 0);
+    double *power = spill.empty() ? local : spill.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double *x = points + i * vars;
+        // Slots are sorted, so each power builds on the previous one of its variable
+        for (size_t s = 0; s < powers.size(); ++s)
+        {
+            auto [v, e] = powers[s];
+            if (s > 0 && powers[s - 1].first == v)
+                power[s] = power[s - 1] * ::power(x[v], e - powers[s - 1].second);
+            else
+                power[s] = ::power(x[v], e);
+        }
+        for (const Step &s : steps)
+        {
+            switch (s.op)
+            {
+            case Step::CONST:
+                reg[s.dst] = s.value;
+                break;
+            case Step::HORNER:
+                reg[s.dst] = reg[s.dst] * power[s.slot] + reg[s.dst + 1];
+                break;
+            case Step::SCALE:
+                reg[s.dst] *= power[s.slot];
+                break;
+            }
+        }
+        out[i] = reg[0];
+    }
+}
@@ -0,0 +1,336 @@
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../polynomial_out_of_core.h"
+
+namespace
+{
+    void readFully(int fd, double *data, uint64_t first, uint64_t count)
+    {
+        char *p = reinterpret_cast<char *>(data);
+        size_t left = count * sizeof(double);
+        off_t offset = static_cast<off_t>(first * sizeof(double));
+        while (left > 0)
+        {
+            ssize_t n = pread(fd, p, left, offset);
+            if (n <= 0)
+                throw runtime_error("Reading coefficients failed.");
+            p += n;
+            left -= n;
+            offset += n;
+        }
+    }
+
+    void writeFully(int fd, const double *data, uint64_t first, uint64_t count)
+    {
+        const char *p = reinterpret_cast<const char *>(data);
+        size_t left = count * sizeof(double);
+        off_t offset = static_cast<off_t>(first * sizeof(double));
+        while (left > 0)
+        {
+            ssize_t n = pwrite(fd, p, left, offset);
+            if (n <= 0)
+                throw runtime_error("Writing coefficients failed.");
+            p += n;
+            left -= n;
+            offset += n;
+        }
+    }
+
+    // Reads a sequence of coefficient ranges on a background thread, keeping
+    // at most DEPTH filled buffers ahead of the consumer
+    class Prefetcher
+    {
+    public:
+        struct Request
+        {
+            int fd;
+            uint64_t first;
+            uint64_t count;
+        };
+
+    private:
+        static const size_t DEPTH = 2;
+
+        function<bool(Request &)> source;
+        mutex lock;
+        condition_variable changed;
+        deque<vector<double>> ready;
+        vector<vector<double>> spare;
+        bool finished = false;
+        bool stopping = false;
+        exception_ptr error;
+        thread worker;
+
+        void run()
+        {
+            try
+            {
+                Request request;
+                while (source(request))
+                {
+                    vector<double> buffer;
+                    {
+                        unique_lock<mutex> guard(lock);
+                        changed.wait(guard, [&]()
+                                     { return ready.size() < DEPTH || stopping; });
+                        if (stopping)
+                            return;
+                        if (!spare.empty())
+                        {
+                            buffer = move(spare.back());
+                            spare.pop_back();
+                        }
+                    }
+                    buffer.resize(request.count);
+                    readFully(request.fd, buffer.data(), request.first, request.count);
+
+                    lock_guard<mutex> guard(lock);
+                    ready.push_back(move(buffer));
+                    changed.notify_all();
+                }
+            }
+            catch (...)
+            {
+                lock_guard<mutex> guard(lock);
+                error = current_exception();
+            }
+            lock_guard<mutex> guard(lock);
+            finished = true;
+            changed.notify_all();
+        }
+
+    public:
+        explicit Prefetcher(function<bool(Request &)> source) : source(move(source))
+        {
+            worker = thread(&Prefetcher::run, this);
+        }
+
+        ~Prefetcher()
+        {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+                changed.notify_all();
+            }
+            worker.join();
+        }
+
+        // Swaps the next block into buffer; the previous contents are reused
+        // for later reads. Returns false once every request has been served.
+        bool next(vector<double> &buffer)
+        {
+            unique_lock<mutex> guard(lock);
+            changed.wait(guard, [&]()
+                         { return !ready.empty() || finished; });
+            if (ready.empty())
+            {
+                if (error)
+                    rethrow_exception(error);
+                return false;
+            }
+            spare.push_back(move(buffer));
+            buffer = move(ready.front());
+            ready.pop_front();
+            changed.notify_all();
+            return true;
+        }
+    };
+}
+
+OutOfCorePolynomial::OutOfCorePolynomial(const string &path) : path(path)
+{
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Cannot open " + path + ".");
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size % sizeof(double) != 0)
+    {
+        close(fd);
+        throw runtime_error(path + " is not a coefficient file.");
+    }
+    count = info.st_size / sizeof(double);
+}
+
+OutOfCorePolynomial::~OutOfCorePolynomial()
+{
+    close(fd);
+}
+
+void OutOfCorePolynomial::write(const string &path, span<const double> coefficients)
+{
+    int out = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0)
+        throw runtime_error("Cannot open " + path + " for writing.");
+    try
+    {
+        writeFully(out, coefficients.data(), 0, coefficients.size());
+    }
+    catch (...)
+    {
+        close(out);
+        throw;
+    }
+    close(out);
+}
+
+uint64_t OutOfCorePolynomial::size() const
+{
+    return count;
+}
+
+int64_t OutOfCorePolynomial::degree() const
+{
+    return static_cast<int64_t>(count) - 1;
+}
+
+void OutOfCorePolynomial::evaluate(const double *xs, double *out, size_t n, size_t blockCoefficients) const
+{
+    blockCoefficients = max<size_t>(blockCoefficients, 1);
+    for (size_t p = 0; p < n; ++p)
+    {
+        out[p] = 0.0;
+    }
+
+    // Blocks from the highest powers down, so plain Horner runs across them
+    uint64_t end = count;
+    Prefetcher prefetch([&](Prefetcher::Request &request)
+                        {
+        if (end == 0)
+            return false;
+        uint64_t first = end > blockCoefficients ? end - blockCoefficients : 0;
+        request = {fd, first, end - first};
+        end = first;
+        return true; });
+
+    vector<double> block;
+    while (prefetch.next(block))
+    {
+        for (size_t i = block.size(); i-- > 0;)
+        {
+            const double c = block[i];
+            for (size_t p = 0; p < n; ++p)
+            {
+                out[p] = out[p] * xs[p] + c;
+            }
+        }
+    }
+}
+
+void OutOfCorePolynomial::multiply(const OutOfCorePolynomial &a, const OutOfCorePolynomial &b, const string &outPath,
+                                   size_t blockCoefficients)
+{
+    blockCoefficients = max<size_t>(blockCoefficients, 1);
+    int out = open(outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0)
+        throw runtime_error("Cannot open " + outPath + " for writing.");
+
+    try
+    {
+        if (a.count > 0 && b.count > 0)
+        {
+            const uint64_t total = a.count + b.count - 1;
+            const uint64_t B = blockCoefficients;
+
+            // For output block [o0, o1) every block [a0, a1) of a pairs with
+            // the slice of b at [max(0, o0 - a1 + 1), min(|b|, o1 - a0)).
+            // The prefetcher reads those pairs in order while the consumer
+            // walks the same sequence with its own cursor.
+            struct Pair
+            {
+                uint64_t o0, a0, a1, b0, b1;
+            };
+            struct PairCursor
+            {
+                uint64_t aCount, bCount, total, B;
+                uint64_t o0 = 0, a0 = 0;
+
+                bool next(Pair &pair)
+                {
+                    for (; o0 < total; o0 += B, a0 = 0)
+                    {
+                        uint64_t o1 = min(total, o0 + B);
+                        while (a0 < aCount && a0 < o1)
+                        {
+                            uint64_t a1 = min(aCount, a0 + B);
+                            uint64_t b0 = o0 + 1 > a1 ? o0 + 1 - a1 : 0;
+                            uint64_t b1 = min(bCount, o1 - a0);
+                            pair = {o0, a0, a1, b0, b1};
+                            a0 = a1;
+                            if (b0 < b1)
+                                return true;
+                        }
+                    }
+                    return false;
+                }
+            };
+
+            PairCursor reads{a.count, b.count, total, B};
+            Pair pending;
+            bool readB = false;
+            Prefetcher prefetch([&](Prefetcher::Request &request)
+                                {
+                if (readB)
+                {
+                    request = {b.fd, pending.b0, pending.b1 - pending.b0};
+                    readB = false;
+                    return true;
+                }
+                if (!reads.next(pending))
+                    return false;
+                request = {a.fd, pending.a0, pending.a1 - pending.a0};
+                readB = true;
+                return true; });
+
+            vector<double> result(min(B, total), 0.0);
+            vector<double> blockA, sliceB;
+            uint64_t current = 0;
+            auto flush = [&](uint64_t o0)
+            {
+                uint64_t n = min(B, total - o0);
+                writeFully(out, result.data(), o0, n);
+                fill(result.begin(), result.end(), 0.0);
+            };
+
+            PairCursor cursor{a.count, b.count, total, B};
+            Pair p;
+            while (cursor.next(p))
+            {
+                if (p.o0 != current)
+                {
+                    flush(current);
+                    current = p.o0;
+                }
+                prefetch.next(blockA);
+                prefetch.next(sliceB);
+                uint64_t o1 = min(total, p.o0 + B);
+                for (uint64_t i = p.a0; i < p.a1; ++i)
+                {
+                    const double ai = blockA[i - p.a0];
+                    // k = i + j must land in [o0, o1) and j in [b0, b1)
+                    uint64_t j0 = max(p.b0, p.o0 > i ? p.o0 - i : 0);
+                    uint64_t j1 = min(p.b1, o1 - i);
+                    for (uint64_t j = j0; j < j1; ++j)
+                    {
+                        result[i + j - p.o0] += ai * sliceB[j - p.b0];
+                    }
+                }
+            }
+            flush(current);
+        }
+    }
+    catch (...)
+    {
+        close(out);
+        throw;
+    }
+    if (close(out) != 0)
+        throw runtime_error("Closing " + outPath + " failed.");
+}
@@ -0,0 +1,275 @@
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "../polynomial_parser.h"
+
+namespace
+{
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    struct Cursor
+    {
+        const char *p;
+        const char *end;
+        const char *begin; // Start of the text, for error positions
+
+        void skipSpaces()
+        {
+            while (p < end && isSpace(*p))
+                ++p;
+        }
+
+        bool done()
+        {
+            skipSpaces();
+            return p == end;
+        }
+    };
+
+    bool fail(string *error, const Cursor &in, const char *message)
+    {
+        if (error)
+            *error = string(message) + " At column " + to_string(in.p - in.begin + 1) + ".";
+        return false;
+    }
+
+    // power must not exceed MAX_DEGREE
+    void addTerm(vector<double> &coeffs, size_t power, double value)
+    {
+        if (power >= coeffs.size())
+            coeffs.resize(power + 1, 0.0);
+        coeffs[power] += value;
+    }
+
+    // "{1, 2, 3}" or "[1 2 3]": coefficients from x^0 upwards
+    bool parseList(Cursor in, vector<double> &coeffs, string *error)
+    {
+        char close = *in.p == '{' ? '}' : ']';
+        ++in.p;
+        size_t power = 0;
+        while (true)
+        {
+            in.skipSpaces();
+            if (in.p < in.end && *in.p == close)
+            {
+                ++in.p;
+                break;
+            }
+            if (power > PolynomialParser::MAX_DEGREE)
+                return fail(error, in, "Coefficient list is longer than MAX_DEGREE + 1.");
+            double value;
+            auto result = from_chars(in.p, in.end, value);
+            if (result.ec != errc())
+                return fail(error, in, "Expected a number in the coefficient list.");
+            in.p = result.ptr;
+            addTerm(coeffs, power++, value);
+            in.skipSpaces();
+            if (in.p < in.end && *in.p == ',')
+                ++in.p;
+        }
+        if (!in.done())
+            return fail(error, in, "Unexpected text after the coefficient list.");
+        return true;
+    }
+
+    // Sum of terms c, cx, cx^n, x, x^n with + or - between them
+    bool parseTerms(Cursor in, vector<double> &coeffs, string *error)
+    {
+        bool first = true;
+        while (!in.done())
+        {
+            double sign = 1.0;
+            if (*in.p == '+' || *in.p == '-')
+            {
+                sign = *in.p == '-' ? -1.0 : 1.0;
+                ++in.p;
+                in.skipSpaces();
+            }
+            else if (!first)
+            {
+                return fail(error, in, "Expected + or - between terms.");
+            }
+            first = false;
+
+            double value = 1.0;
+            bool hasNumber = false;
+            if (in.p < in.end && *in.p != 'x')
+            {
+                auto result = from_chars(in.p, in.end, value);
+                if (result.ec != errc())
+                    return fail(error, in, "Expected a coefficient.");
+                in.p = result.ptr;
+                hasNumber = true;
+                in.skipSpaces();
+                if (in.p < in.end && *in.p == '*')
+                {
+                    ++in.p;
+                    in.skipSpaces();
+                }
+            }
+
+            size_t power = 0;
+            if (in.p < in.end && *in.p == 'x')
+            {
+                ++in.p;
+                power = 1;
+                in.skipSpaces();
+                if (in.p < in.end && *in.p == '^')
+                {
+                    ++in.p;
+                    in.skipSpaces();
+                    auto result = from_chars(in.p, in.end, power);
+                    if (result.ec != errc())
+                        return fail(error, in, "Expected an exponent after ^.");
+                    if (power > PolynomialParser::MAX_DEGREE)
+                        return fail(error, in, "Exponent is larger than MAX_DEGREE.");
+                    in.p = result.ptr;
+                }
+            }
+            else if (!hasNumber)
+            {
+                return fail(error, in, "Expected a term.");
+            }
+
+            addTerm(coeffs, power, sign * value);
+        }
+        return true;
+    }
+}
+
+bool PolynomialParser::parse(string_view text, vector<double> &coeffs, string *error)
+{
+    coeffs.clear();
+    Cursor in{text.data(), text.data() + text.size(), text.data()};
+    if (in.done())
+    {
+        coeffs.push_back(0.0); // Empty text is the zero polynomial
+        return true;
+    }
+
+    bool ok = (*in.p == '{' || *in.p == '[') ? parseList(in, coeffs, error) : parseTerms(in, coeffs, error);
+    if (ok && coeffs.empty())
+        coeffs.push_back(0.0);
+    return ok;
+}
+
+Polynomial PolynomialParser::parse(string_view text)
+{
+    vector<double> coeffs;
+    string error;
+    if (!parse(text, coeffs, &error))
+        throw invalid_argument(error + " In: " + string(text));
+    return Polynomial(coeffs);
+}
+
+PolynomialParser::FileStats PolynomialParser::parseFile(const string &path, const LineCallback &callback,
+                                                        unsigned threads, size_t chunkBytes)
+{
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw runtime_error("Cannot open " + path + ".");
+
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    chunkBytes = max<size_t>(chunkBytes, 1 << 16);
+
+    FileStats total;
+    vector<char> buffer(chunkBytes);
+    size_t carried = 0; // Bytes of an unfinished line kept from the previous chunk
+
+    while (true)
+    {
+        in.read(buffer.data() + carried, buffer.size() - carried);
+        size_t filled = carried + in.gcount();
+        bool last = in.gcount() == 0 || in.eof();
+        if (filled == 0)
+            break;
+
+        // Only complete lines are parsed now, unless this is the end of the file
+        size_t usable = filled;
+        if (!last)
+        {
+            const char *cut = static_cast<const char *>(memrchr(buffer.data(), '\n', filled));
+            if (cut == nullptr)
+            {
+                // One line longer than the buffer: grow and read more
+                buffer.resize(buffer.size() * 2);
+                carried = filled;
+                continue;
+            }
+            usable = cut - buffer.data() + 1;
+        }
+
+        // Split the usable bytes into one range per worker at line starts
+        vector<size_t> bounds{0};
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            size_t at = max(bounds.back(), usable * t / threads);
+            const void *nl = at < usable ? memchr(buffer.data() + at, '\n', usable - at) : nullptr;
+            at = nl ? static_cast<const char *>(nl) - buffer.data() + 1 : usable;
+            bounds.push_back(at);
+        }
+        bounds.push_back(usable);
+
+        // Line numbers of each range start, so callbacks get file line numbers
+        vector<size_t> firstLine(bounds.size() - 1);
+        size_t line = total.lines;
+        for (size_t r = 0; r + 1 < bounds.size(); ++r)
+        {
+            firstLine[r] = line + 1;
+            line += count(buffer.begin() + bounds[r], buffer.begin() + bounds[r + 1], '\n');
+        }
+
+        vector<FileStats> stats(bounds.size() - 1);
+        auto work = [&](size_t r)
+        {
+            vector<double> coeffs;
+            size_t number = firstLine[r];
+            const char *p = buffer.data() + bounds[r];
+            const char *end = buffer.data() + bounds[r + 1];
+            while (p < end)
+            {
+                const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
+                const char *lineEnd = nl ? nl : end;
+                if (parse(string_view(p, lineEnd - p), coeffs))
+                {
+                    callback(number, PolynomialView(span<const double>(coeffs)));
+                }
+                else
+                {
+                    if (stats[r].failures++ == 0)
+                        stats[r].firstFailure = number;
+                }
+                ++stats[r].lines;
+                ++number;
+                p = nl ? nl + 1 : end;
+            }
+        };
+
+        vector<thread> workers;
+        for (size_t r = 1; r < stats.size(); ++r)
+            workers.emplace_back(work, r);
+        work(0);
+        for (thread &w : workers)
+            w.join();
+
+        for (const FileStats &s : stats)
+        {
+            if (s.failures > 0 && total.firstFailure == 0)
+                total.firstFailure = s.firstFailure;
+            total.lines += s.lines;
+            total.failures += s.failures;
+        }
+
+        carried = filled - usable;
+        memmove(buffer.data(), buffer.data() + usable, carried);
+        if (last)
+            break;
+    }
+    return total;
+}
@@ -0,0 +1,107 @@
+#include <charconv>
+#include <stdexcept>
+#include "../polynomial_pipeline.h"
+#include "../polynomial_parser.h"
+#include "../polynomial_format.h"
+
+static vector<double> parseNumbers(const string &text)
+{
+    vector<double> values;
+    const char *p = text.data(), *end = text.data() + text.size();
+    while (p < end)
+    {
+        double value;
+        auto [next, ec] = from_chars(p, end, value);
+        if (ec != errc() || (next < end && *next != ','))
+            throw invalid_argument("Bad number list: " + text);
+        values.push_back(value);
+        p = next < end ? next + 1 : next;
+    }
+    if (values.empty())
+        throw invalid_argument("Empty number list.");
+    return values;
+}
+
+void PolynomialPipeline::add(const string &spec)
+{
+    if (!steps.empty() && (steps.back().kind == EVALUATE || steps.back().kind == ROOTS))
+        throw invalid_argument("Nothing can follow " + string(steps.back().kind == EVALUATE ? "evaluate" : "roots") + ".");
+
+    Step step{DERIVATIVE, Polynomial(), {}};
+    if (spec == "derivative")
+        step.kind = DERIVATIVE;
+    else if (spec == "integral")
+        step.kind = INTEGRAL;
+    else if (spec.rfind("compose=", 0) == 0)
+    {
+        step.kind = COMPOSE;
+        step.inner = PolynomialParser::parse(string_view(spec).substr(8));
+    }
+    else if (spec.rfind("evaluate@", 0) == 0)
+    {
+        step.kind = EVALUATE;
+        step.values = parseNumbers(spec.substr(9));
+    }
+    else if (spec == "roots")
+    {
+        step.kind = ROOTS;
+        step.values = {1.0};
+    }
+    else if (spec.rfind("roots@", 0) == 0)
+    {
+        step.kind = ROOTS;
+        step.values = parseNumbers(spec.substr(6));
+    }
+    else
+        throw invalid_argument("Unknown step " + spec + ".");
+    steps.push_back(step);
+}
+
+size_t PolynomialPipeline::size() const
+{
+    return steps.size();
+}
+
+bool PolynomialPipeline::apply(const Polynomial &p, string &out) const
+{
+    size_t start = out.size();
+    try
+    {
+        Polynomial current = p;
+        for (const Step &step : steps)
+        {
+            if (step.kind == DERIVATIVE)
+                current = current.derivative();
+            else if (step.kind == INTEGRAL)
+                current = current.integral();
+            else if (step.kind == COMPOSE)
+                current = current.compose(step.inner);
+            else
+            {
+                // Terminal step: numbers instead of a polynomial
+                char buf[32];
+                for (size_t i = 0; i < step.values.size(); ++i)
+                {
+                    double value = step.kind == EVALUATE ? current.evaluate(step.values[i])
+                                                         : current.getRoot(step.values[i]);
+                    if (i > 0)
+                        out += ',';
+                    out.append(buf, to_chars(buf, buf + sizeof(buf), value).ptr);
+                }
+                out += '\n';
+                return true;
+            }
+        }
+        PolynomialFormatter::appendTo(out, current);
+        out += '\n';
+        return true;
+    }
+    catch (const exception &e)
+    {
+        out.resize(start);
+        out += "error: ";
+        out += e.what();
+        out += '\n';
+        return false;
+    }
+}
@@ -0,0 +1,112 @@
+#include "../polynomial.h"
+
+// Evaluation plan (Paterson-Stockmeyer splitting)
+//
+// p(x) = B_0(x) + B_1(x) x^k + B_2(x) x^2k + ...
+// where every block B_b has k coefficients. The powers x^1..x^k are built once
+// per point, each block is an independent dot product with those powers and the
+// blocks are joined by Horner in x^k. The dependent multiply chain per point
+// drops from n (plain Horner) to about 2 sqrt(n).
+
+Polynomial::Plan::Plan() : coeffs(1, 0.0), blockSize(1), realDegree(0) {}
+
+Polynomial::Plan::Plan(const vector<double> &coefficients)
+{
+    // Ignore trailing zero coefficients
+    int n = static_cast<int>(coefficients.size());
+    while (n > 1 && coefficients[n - 1] == 0)
+        --n;
+    realDegree = n > 0 ? n - 1 : 0;
+
+    blockSize = static_cast<int>(ceil(sqrt(static_cast<double>(realDegree + 1))));
+    blockSize = max(1, min(blockSize, MAX_BLOCK));
+
+    // Pad up to a whole number of blocks so the inner loop has no tail
+    int blocks = (realDegree + blockSize) / blockSize;
+    coeffs.assign(blocks * blockSize, 0.0);
+    for (int i = 0; i < n; ++i)
+    {
+        coeffs[i] = coefficients[i];
+    }
+}
+
+int Polynomial::Plan::degree() const
+{
+    return realDegree;
+}
+
+double Polynomial::Plan::evaluate(double x) const
+{
+    const int k = blockSize;
+    double powers[MAX_BLOCK + 1];
+    powers[0] = 1.0;
+    for (int j = 1; j <= k; ++j)
+    {
+        powers[j] = powers[j - 1] * x;
+    }
+
+    double result = 0.0;
+    for (int b = static_cast<int>(coeffs.size()) - k; b >= 0; b -= k)
+    {
+        double block = 0.0;
+        for (int j = 0; j < k; ++j)
+        {
+            block += coeffs[b + j] * powers[j];
+        }
+        result = result * powers[k] + block;
+    }
+    return result;
+}
+
+void Polynomial::Plan::evaluate(const double *xs, double *out, size_t n) const
+{
+    // Points are processed in groups of LANES so the innermost loops run across
+    // independent points and can be vectorized by the compiler.
+    const size_t LANES = 8;
+    const int k = blockSize;
+    double powers[MAX_BLOCK + 1][LANES];
+
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            powers[0][l] = 1.0;
+        }
+        for (int j = 1; j <= k; ++j)
+        {
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                powers[j][l] = powers[j - 1][l] * xs[i + l];
+            }
+        }
+
+        double result[LANES] = {};
+        for (int b = static_cast<int>(coeffs.size()) - k; b >= 0; b -= k)
+        {
+            double block[LANES] = {};
+            for (int j = 0; j < k; ++j)
+            {
+                const double c = coeffs[b + j];
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    block[l] += c * powers[j][l];
+                }
+            }
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                result[l] = result[l] * powers[k][l] + block[l];
+            }
+        }
+
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            out[i + l] = result[l];
+        }
+    }
+
+    for (; i < n; ++i)
+    {
+        out[i] = evaluate(xs[i]);
+    }
+}
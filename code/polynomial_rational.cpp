@@ -0,0 +1,591 @@
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+#include "../polynomial_rational.h"
+#include "../polynomial_view.h"
+
+namespace
+{
+    // Coefficient vectors below always hold at least one entry; {0} is zero
+
+    vector<double> coefficientsOf(const Polynomial &p)
+    {
+        span<const double> c = PolynomialView(p).coefficients();
+        return c.empty() ? vector<double>(1, 0.0) : vector<double>(c.begin(), c.end());
+    }
+
+    double maxNorm(const vector<double> &a)
+    {
+        double result = 0;
+        for (double c : a)
+        {
+            result = max(result, fabs(c));
+        }
+        return result;
+    }
+
+    // Drop leading coefficients no larger than tolerance
+    void trim(vector<double> &a, double tolerance)
+    {
+        while (a.size() > 1 && fabs(a.back()) <= tolerance)
+            a.pop_back();
+        if (a.size() == 1 && fabs(a[0]) <= tolerance)
+            a[0] = 0;
+    }
+
+    bool isZero(const vector<double> &a)
+    {
+        return a.size() == 1 && a[0] == 0;
+    }
+
+    void scale(vector<double> &a, double factor)
+    {
+        for (double &c : a)
+        {
+            c *= factor;
+        }
+    }
+
+    vector<double> multiply(const vector<double> &a, const vector<double> &b)
+    {
+        vector<double> result(a.size() + b.size() - 1);
+        PolynomialView::multiply(span<const double>(a), span<const double>(b), result);
+        return result;
+    }
+
+    vector<double> add(const vector<double> &a, const vector<double> &b)
+    {
+        vector<double> result(max(a.size(), b.size()));
+        PolynomialView::add(span<const double>(a), span<const double>(b), result);
+        trim(result, 0);
+        return result;
+    }
+
+    vector<double> subtract(const vector<double> &a, const vector<double> &b)
+    {
+        vector<double> result(max(a.size(), b.size()));
+        PolynomialView::subtract(span<const double>(a), span<const double>(b), result);
+        trim(result, 0);
+        return result;
+    }
+
+    vector<double> derivativeOf(const vector<double> &a)
+    {
+        if (a.size() == 1)
+            return {0};
+        vector<double> result(a.size() - 1);
+        PolynomialView::derivative(span<const double>(a), result);
+        return result;
+    }
+
+    // Long division a = q b + r with deg r < deg b; b must have a nonzero leading coefficient
+    void divide(const vector<double> &a, const vector<double> &b, vector<double> &q, vector<double> &r)
+    {
+        size_t nb = b.size();
+        r = a;
+        if (a.size() < nb)
+        {
+            q.assign(1, 0.0);
+            return;
+        }
+        q.assign(a.size() - nb + 1, 0.0);
+        for (size_t i = q.size(); i-- > 0;)
+        {
+            double c = r[i + nb - 1] / b.back();
+            q[i] = c;
+            for (size_t j = 0; j < nb; ++j)
+            {
+                r[i + j] -= c * b[j];
+            }
+        }
+        r.resize(max<size_t>(nb - 1, 1));
+        if (nb == 1)
+            r[0] = 0;
+        trim(r, 0);
+    }
+
+    vector<double> quotient(const vector<double> &a, const vector<double> &b)
+    {
+        vector<double> q, r;
+        divide(a, b, q, r);
+        return q;
+    }
+
+    // Remainder of a by g is within tolerance of zero, relative to a
+    bool divides(const vector<double> &g, const vector<double> &a, double tolerance)
+    {
+        vector<double> q, r;
+        divide(a, g, q, r);
+        return maxNorm(r) <= tolerance * maxNorm(a) * a.size();
+    }
+
+    // Monic greatest common divisor. Both operands are scaled to unit norm at
+    // every step so the tolerance stays relative. The result is only accepted
+    // if it divides both operands to the same tolerance; otherwise they are
+    // treated as coprime.
+    vector<double> gcd(const vector<double> &x, const vector<double> &y, double tolerance)
+    {
+        vector<double> a = x, b = y;
+        if (isZero(a))
+            swap(a, b);
+        if (isZero(a))
+            return {1};
+        scale(a, 1 / maxNorm(a));
+        if (!isZero(b))
+            scale(b, 1 / maxNorm(b));
+        trim(a, tolerance);
+        trim(b, tolerance);
+
+        while (!isZero(b) && b.size() > 1)
+        {
+            vector<double> q, r;
+            divide(a, b, q, r);
+            trim(r, tolerance);
+            a = move(b);
+            b = move(r);
+            if (!isZero(b))
+            {
+                scale(b, 1 / maxNorm(b));
+                trim(b, tolerance);
+            }
+        }
+        // A nonzero constant remainder means the operands are coprime
+        if (!isZero(b))
+            return {1};
+        scale(a, 1 / a.back());
+        if (a.size() > 1 && !(divides(a, x, tolerance) && divides(a, y, tolerance)))
+            return {1};
+        return a;
+    }
+
+    // Yun's square-free factorization: f = lead * prod factors[i]^(i + 1), each
+    // factor square-free (possibly constant)
+    vector<vector<double>> squareFree(const vector<double> &f, double tolerance)
+    {
+        vector<vector<double>> factors;
+        vector<double> a = gcd(f, derivativeOf(f), tolerance);
+        vector<double> b = quotient(f, a);
+        vector<double> c = quotient(derivativeOf(f), a);
+        vector<double> d = subtract(c, derivativeOf(b));
+        // Bounded by the degree in case rounding stalls the GCDs
+        for (size_t i = 0; b.size() > 1 && i < f.size(); ++i)
+        {
+            a = gcd(b, d, tolerance);
+            factors.push_back(a);
+            b = quotient(b, a);
+            c = quotient(d, a);
+            d = subtract(c, derivativeOf(b));
+        }
+        return factors;
+    }
+
+    // All complex roots of a square-free polynomial by Durand-Kerner iteration
+    vector<complex<double>> complexRoots(vector<double> f)
+    {
+        int n = static_cast<int>(f.size()) - 1;
+        scale(f, 1 / f.back());
+        if (n == 1)
+            return {complex<double>(-f[0], 0)};
+
+        auto evaluate = [&](complex<double> z)
+        {
+            complex<double> result = 0;
+            for (int i = n; i >= 0; --i)
+            {
+                result = result * z + f[i];
+            }
+            return result;
+        };
+
+        // Start on a circle enclosing every root, at angles that avoid symmetry
+        double radius = 1;
+        for (int i = 0; i < n; ++i)
+        {
+            radius = max(radius, 1 + fabs(f[i]));
+        }
+        vector<complex<double>> z(n);
+        for (int k = 0; k < n; ++k)
+        {
+            z[k] = polar(radius, 2 * numbers::pi * k / n + 0.4);
+        }
+
+        for (int iter = 0; iter < 1000; ++iter)
+        {
+            double change = 0;
+            for (int k = 0; k < n; ++k)
+            {
+                complex<double> denominator = 1;
+                for (int j = 0; j < n; ++j)
+                {
+                    if (j != k)
+                        denominator *= z[k] - z[j];
+                }
+                complex<double> step = evaluate(z[k]) / denominator;
+                z[k] -= step;
+                change = max(change, abs(step) / (1 + abs(z[k])));
+            }
+            if (change < 1e-15)
+                break;
+        }
+        return z;
+    }
+
+    // Solve A x = rhs by Gaussian elimination with partial pivoting
+    vector<double> solve(vector<vector<double>> A, vector<double> rhs)
+    {
+        size_t n = rhs.size();
+        for (size_t col = 0; col < n; ++col)
+        {
+            size_t pivot = col;
+            for (size_t row = col + 1; row < n; ++row)
+            {
+                if (fabs(A[row][col]) > fabs(A[pivot][col]))
+                    pivot = row;
+            }
+            if (A[pivot][col] == 0)
+                throw runtime_error("Partial fraction system is singular.");
+            swap(A[col], A[pivot]);
+            swap(rhs[col], rhs[pivot]);
+            for (size_t row = col + 1; row < n; ++row)
+            {
+                double factor = A[row][col] / A[col][col];
+                for (size_t k = col; k < n; ++k)
+                {
+                    A[row][k] -= factor * A[col][k];
+                }
+                rhs[row] -= factor * rhs[col];
+            }
+        }
+        vector<double> x(n);
+        for (size_t row = n; row-- > 0;)
+        {
+            double sum = rhs[row];
+            for (size_t k = row + 1; k < n; ++k)
+            {
+                sum -= A[row][k] * x[k];
+            }
+            x[row] = sum / A[row][row];
+        }
+        return x;
+    }
+}
+
+// Constructors
+RationalFunction::RationalFunction() : num(vector<double>{0}), den(vector<double>{1}), tolerance(EXACT_TOLERANCE)
+{
+    reduce();
+}
+
+RationalFunction::RationalFunction(const Polynomial &numerator)
+    : num(numerator), den(vector<double>{1}), tolerance(EXACT_TOLERANCE)
+{
+    reduce();
+}
+
+RationalFunction::RationalFunction(const Polynomial &numerator, const Polynomial &denominator, double tolerance)
+    : num(numerator), den(denominator), tolerance(tolerance)
+{
+    if (!(tolerance >= EXACT_TOLERANCE))
+        throw invalid_argument("Tolerance must be at least EXACT_TOLERANCE.");
+    reduce();
+}
+
+void RationalFunction::reduce()
+{
+    vector<double> n = coefficientsOf(num), d = coefficientsOf(den);
+    trim(n, 0);
+    trim(d, 0);
+    if (isZero(d))
+        throw invalid_argument("Denominator must not be zero.");
+
+    if (isZero(n))
+        d = {1};
+    else
+    {
+        vector<double> g = gcd(n, d, tolerance);
+        if (g.size() > 1)
+        {
+            n = quotient(n, g);
+            d = quotient(d, g);
+        }
+    }
+    double lead = 1 / d.back();
+    scale(n, lead);
+    scale(d, lead);
+    num = Polynomial(n);
+    den = Polynomial(d);
+
+    size_t len = max(n.size(), d.size());
+    fused.assign(2 * len, 0.0);
+    for (size_t i = 0; i < n.size(); ++i)
+    {
+        fused[2 * i] = n[i];
+    }
+    for (size_t i = 0; i < d.size(); ++i)
+    {
+        fused[2 * i + 1] = d[i];
+    }
+}
+
+// Arithmetic operators
+// Products go through the vector helpers, which keep at least one
+// coefficient even when a backend stores zero as an empty polynomial.
+// Results use the looser of the two tolerances.
+RationalFunction RationalFunction::operator+(const RationalFunction &other) const
+{
+    // a/b + c/d over lcm(b, d) = b (d / g)
+    double t = max(tolerance, other.tolerance);
+    vector<double> a = coefficientsOf(num), b = coefficientsOf(den);
+    vector<double> c = coefficientsOf(other.num), d = coefficientsOf(other.den);
+    vector<double> g = gcd(b, d, t), bg = quotient(b, g), dg = quotient(d, g);
+    return RationalFunction(Polynomial(add(multiply(a, dg), multiply(c, bg))), Polynomial(multiply(b, dg)), t);
+}
+
+RationalFunction RationalFunction::operator-(const RationalFunction &other) const
+{
+    double t = max(tolerance, other.tolerance);
+    vector<double> a = coefficientsOf(num), b = coefficientsOf(den);
+    vector<double> c = coefficientsOf(other.num), d = coefficientsOf(other.den);
+    vector<double> g = gcd(b, d, t), bg = quotient(b, g), dg = quotient(d, g);
+    return RationalFunction(Polynomial(subtract(multiply(a, dg), multiply(c, bg))), Polynomial(multiply(b, dg)), t);
+}
+
+RationalFunction RationalFunction::operator*(const RationalFunction &other) const
+{
+    return RationalFunction(Polynomial(multiply(coefficientsOf(num), coefficientsOf(other.num))),
+                            Polynomial(multiply(coefficientsOf(den), coefficientsOf(other.den))),
+                            max(tolerance, other.tolerance));
+}
+
+RationalFunction RationalFunction::operator/(const RationalFunction &other) const
+{
+    return RationalFunction(Polynomial(multiply(coefficientsOf(num), coefficientsOf(other.den))),
+                            Polynomial(multiply(coefficientsOf(den), coefficientsOf(other.num))),
+                            max(tolerance, other.tolerance));
+}
+
+// Output operator (friend)
+ostream &operator<<(ostream &out, const RationalFunction &r)
+{
+    out << "(" << r.num << ") / (" << r.den << ")";
+    return out;
+}
+
+// Utility functions
+const Polynomial &RationalFunction::numerator() const
+{
+    return num;
+}
+
+const Polynomial &RationalFunction::denominator() const
+{
+    return den;
+}
+
+double RationalFunction::evaluate(double x) const
+{
+    // Two independent Horner chains over one interleaved array
+    double p = 0, q = 0;
+    for (size_t i = fused.size(); i > 0; i -= 2)
+    {
+        p = p * x + fused[i - 2];
+        q = q * x + fused[i - 1];
+    }
+    return p / q;
+}
+
+void RationalFunction::evaluate(const double *xs, double *out, size_t n) const
+{
+    // Points are processed in groups of LANES, as in Plan::evaluate
+    const size_t LANES = 8;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        double p[LANES] = {}, q[LANES] = {};
+        for (size_t k = fused.size(); k > 0; k -= 2)
+        {
+            const double a = fused[k - 2], b = fused[k - 1];
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                p[l] = p[l] * xs[i + l] + a;
+                q[l] = q[l] * xs[i + l] + b;
+            }
+        }
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            out[i + l] = p[l] / q[l];
+        }
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = evaluate(xs[i]);
+    }
+}
+
+RationalFunction RationalFunction::derivative() const
+{
+    // With d = g h and d' = g k for g = gcd(d, d'):
+    //   (n / d)' = (n' d - n d') / d^2 = (n' h - n k) / (g h^2)
+    vector<double> n = coefficientsOf(num), d = coefficientsOf(den), dd = derivativeOf(d);
+    vector<double> g = gcd(d, dd, tolerance), h = quotient(d, g), k = quotient(dd, g);
+    return RationalFunction(Polynomial(subtract(multiply(derivativeOf(n), h), multiply(n, k))),
+                            Polynomial(multiply(multiply(g, h), h)), tolerance);
+}
+
+RationalFunction::PartialFractions RationalFunction::partialFractions() const
+{
+    PartialFractions result;
+    vector<double> d = coefficientsOf(den), q, r;
+    divide(coefficientsOf(num), d, q, r);
+    result.polynomial = Polynomial(q);
+    if (d.size() == 1)
+        return result;
+
+    // Monic irreducible factors (x - root or x^2 + p x + q) with multiplicities
+    struct Factor
+    {
+        vector<double> poly;
+        int multiplicity;
+    };
+    vector<Factor> factors;
+    vector<vector<double>> squareFreeParts = squareFree(d, tolerance);
+    for (size_t m = 0; m < squareFreeParts.size(); ++m)
+    {
+        if (squareFreeParts[m].size() == 1)
+            continue;
+        for (complex<double> z : complexRoots(squareFreeParts[m]))
+        {
+            double tolerance = 1e-8 * (1 + abs(z));
+            if (fabs(z.imag()) <= tolerance)
+                factors.push_back({{-z.real(), 1}, static_cast<int>(m + 1)});
+            else if (z.imag() > 0)
+                factors.push_back({{std::norm(z), -2 * z.real(), 1}, static_cast<int>(m + 1)});
+        }
+    }
+
+    // One unknown per power of a linear factor and two per power of a
+    // quadratic one, matched against the coefficients of the remainder:
+    //   r = sum a_k (d / f^k) + sum (b_k x + c_k) (d / f^k)
+    size_t n = d.size() - 1;
+    vector<vector<double>> columns;
+    for (size_t i = 0; i < factors.size(); ++i)
+    {
+        vector<double> others{1};
+        for (size_t j = 0; j < factors.size(); ++j)
+        {
+            for (int k = 0; j != i && k < factors[j].multiplicity; ++k)
+            {
+                others = multiply(others, factors[j].poly);
+            }
+        }
+        // others * f^(m - k) for k = m down to 1
+        vector<vector<double>> bases;
+        vector<double> basis = others;
+        for (int k = factors[i].multiplicity; k >= 1; --k)
+        {
+            bases.push_back(basis);
+            basis = multiply(basis, factors[i].poly);
+        }
+        for (int k = 1; k <= factors[i].multiplicity; ++k)
+        {
+            const vector<double> &base = bases[factors[i].multiplicity - k];
+            if (factors[i].poly.size() == 3)
+                columns.push_back(multiply(base, {0, 1}));
+            columns.push_back(base);
+        }
+    }
+    if (columns.size() != n)
+        throw runtime_error("Could not factor the denominator.");
+
+    vector<vector<double>> A(n, vector<double>(n, 0.0));
+    for (size_t j = 0; j < n; ++j)
+    {
+        for (size_t i = 0; i < columns[j].size() && i < n; ++i)
+        {
+            A[i][j] = columns[j][i];
+        }
+    }
+    r.resize(n, 0.0);
+    vector<double> x = solve(A, r);
+
+    size_t next = 0;
+    for (const Factor &f : factors)
+    {
+        for (int k = 1; k <= f.multiplicity; ++k)
+        {
+            if (f.poly.size() == 2)
+                result.linear.push_back({-f.poly[0], k, x[next++]});
+            else
+            {
+                double b = x[next++], c = x[next++];
+                result.quadratic.push_back({f.poly[1], f.poly[0], k, b, c});
+            }
+        }
+    }
+    return result;
+}
+
+double RationalFunction::integral(double x1, double x2) const
+{
+    return partialFractions().integral(x1, x2);
+}
+
+// Partial fractions
+double RationalFunction::PartialFractions::evaluate(double x) const
+{
+    double result = polynomial.evaluate(x);
+    for (const Linear &t : linear)
+    {
+        result += t.a / pow(x - t.root, t.power);
+    }
+    for (const Quadratic &t : quadratic)
+    {
+        result += (t.b * x + t.c) / pow(x * x + t.p * x + t.q, t.power);
+    }
+    return result;
+}
+
+double RationalFunction::PartialFractions::antiderivative(double x) const
+{
+    double result = polynomial.cachedIntegral().evaluate(x);
+    for (const Linear &t : linear)
+    {
+        if (t.power == 1)
+            result += t.a * log(fabs(x - t.root));
+        else
+            result -= t.a / ((t.power - 1) * pow(x - t.root, t.power - 1));
+    }
+    for (const Quadratic &t : quadratic)
+    {
+        // With s = x + p / 2 and w^2 = q - p^2 / 4 the term is
+        //   (b s + e) / (s^2 + w^2)^k,  e = c - b p / 2
+        double s = x + t.p / 2, w2 = t.q - t.p * t.p / 4, w = sqrt(w2);
+        double u = s * s + w2, e = t.c - t.b * t.p / 2;
+        int k = t.power;
+
+        if (k == 1)
+            result += t.b / 2 * log(u);
+        else
+            result -= t.b / (2 * (k - 1) * pow(u, k - 1));
+
+        // I_1 = atan(s / w) / w,
+        // I_j = s / (2 w^2 (j - 1) u^(j - 1)) + (2j - 3) / (2 w^2 (j - 1)) I_(j-1)
+        double I = atan(s / w) / w;
+        for (int j = 2; j <= k; ++j)
+        {
+            I = s / (2 * w2 * (j - 1) * pow(u, j - 1)) + (2 * j - 3) / (2 * w2 * (j - 1)) * I;
+        }
+        result += e * I;
+    }
+    return result;
+}
+
+double RationalFunction::PartialFractions::integral(double x1, double x2) const
+{
+    for (const Linear &t : linear)
+    {
+        if (t.root >= min(x1, x2) && t.root <= max(x1, x2))
+            throw domain_error("Integration interval contains a pole.");
+    }
+    return antiderivative(x2) - antiderivative(x1);
+}
@@ -0,0 +1,256 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../polynomial_service.h"
+
+using namespace polyservice;
+
+namespace
+{
+    bool readAll(int fd, void *data, size_t size)
+    {
+        char *p = static_cast<char *>(data);
+        while (size > 0)
+        {
+            ssize_t n = recv(fd, p, size, 0);
+            if (n <= 0)
+                return false;
+            p += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    bool writeAll(int fd, const void *data, size_t size)
+    {
+        const char *p = static_cast<const char *>(data);
+        while (size > 0)
+        {
+            ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+            if (n <= 0)
+                return false;
+            p += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    sockaddr_un address(const string &path)
+    {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path))
+            throw invalid_argument("Socket path is too long.");
+        memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        return addr;
+    }
+}
+
+// Server
+PolynomialServer::PolynomialServer(const vector<Polynomial> &polynomials, const string &socketPath,
+                                   PolynomialServiceOptions options)
+    : options(options), socketPath(socketPath)
+{
+    for (const Polynomial &p : polynomials)
+    {
+        plans.push_back(p.plan());
+        queues.push_back(make_unique<Queue>());
+    }
+
+    sockaddr_un addr = address(socketPath);
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        throw runtime_error("Cannot create socket.");
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0)
+    {
+        close(listenFd);
+        throw runtime_error("Cannot listen on " + socketPath + ".");
+    }
+}
+
+PolynomialServer::~PolynomialServer()
+{
+    stop();
+    close(listenFd);
+    unlink(socketPath.c_str());
+}
+
+void PolynomialServer::run()
+{
+    while (!stopping.load())
+    {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break; // stop() shut the listening socket down
+        }
+        lock_guard<mutex> guard(connectionsLock);
+        if (stopping.load())
+        {
+            close(fd);
+            break;
+        }
+        connections.push_back(fd);
+        thread(&PolynomialServer::serve, this, fd).detach();
+    }
+
+    unique_lock<mutex> guard(connectionsLock);
+    connectionClosed.wait(guard, [&]()
+                          { return connections.empty(); });
+}
+
+void PolynomialServer::stop()
+{
+    stopping.store(true);
+    shutdown(listenFd, SHUT_RDWR);
+    lock_guard<mutex> guard(connectionsLock);
+    for (int fd : connections)
+    {
+        shutdown(fd, SHUT_RDWR);
+    }
+}
+
+size_t PolynomialServer::requestCount() const
+{
+    return requests.load();
+}
+
+size_t PolynomialServer::batchCount() const
+{
+    return batches.load();
+}
+
+void PolynomialServer::serve(int fd)
+{
+    vector<double> xs, out;
+    RequestHeader request;
+    while (readAll(fd, &request, sizeof(request)))
+    {
+        ResponseHeader response{OK, request.count};
+        if (request.count > MAX_POINTS)
+        {
+            response = {TOO_MANY_POINTS, 0};
+            writeAll(fd, &response, sizeof(response));
+            break;
+        }
+
+        xs.resize(request.count);
+        out.resize(request.count);
+        if (!readAll(fd, xs.data(), xs.size() * sizeof(double)))
+            break;
+
+        if (request.index >= plans.size())
+            response = {UNKNOWN_POLYNOMIAL, 0};
+        else
+            evaluate(request.index, xs.data(), out.data(), xs.size());
+
+        if (!writeAll(fd, &response, sizeof(response)) ||
+            !writeAll(fd, out.data(), response.count * sizeof(double)))
+            break;
+        if (response.status == OK)
+            requests.fetch_add(1, memory_order_relaxed);
+    }
+
+    lock_guard<mutex> guard(connectionsLock);
+    connections.erase(find(connections.begin(), connections.end(), fd));
+    close(fd);
+    connectionClosed.notify_all();
+}
+
+void PolynomialServer::evaluate(uint32_t index, const double *xs, double *out, size_t n)
+{
+    Queue &queue = *queues[index];
+    Pending self{xs, out, n, false};
+
+    unique_lock<mutex> guard(queue.lock);
+    queue.batch.push_back(&self);
+    queue.points += n;
+
+    if (queue.leaderWaiting)
+    {
+        if (queue.points >= options.maxBatch)
+            queue.changed.notify_all();
+        queue.changed.wait(guard, [&]()
+                           { return self.done; });
+        return;
+    }
+
+    // Leader: collect until the window closes or the batch is full
+    queue.leaderWaiting = true;
+    auto deadline = chrono::steady_clock::now() + chrono::microseconds(options.windowMicros);
+    queue.changed.wait_until(guard, deadline, [&]()
+                             { return queue.points >= options.maxBatch; });
+    vector<Pending *> batch;
+    batch.swap(queue.batch);
+    size_t points = queue.points;
+    queue.points = 0;
+    queue.leaderWaiting = false;
+    guard.unlock();
+
+    // Gather into one contiguous run so the plan evaluates all points at once
+    vector<double> allX(points), allY(points);
+    size_t offset = 0;
+    for (Pending *p : batch)
+    {
+        copy(p->xs, p->xs + p->count, allX.begin() + offset);
+        offset += p->count;
+    }
+    plans[index].evaluate(allX.data(), allY.data(), points);
+    batches.fetch_add(1, memory_order_relaxed);
+
+    guard.lock();
+    offset = 0;
+    for (Pending *p : batch)
+    {
+        copy(allY.begin() + offset, allY.begin() + offset + p->count, p->out);
+        offset += p->count;
+        p->done = true;
+    }
+    queue.changed.notify_all();
+}
+
+// Client
+PolynomialClient::PolynomialClient(const string &socketPath)
+{
+    sockaddr_un addr = address(socketPath);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw runtime_error("Cannot create socket.");
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        throw runtime_error("Cannot connect to " + socketPath + ".");
+    }
+}
+
+PolynomialClient::~PolynomialClient()
+{
+    close(fd);
+}
+
+void PolynomialClient::evaluate(uint32_t index, const double *xs, size_t n, double *out)
+{
+    if (n > MAX_POINTS)
+        throw invalid_argument("Too many points in one request.");
+
+    RequestHeader request{index, static_cast<uint32_t>(n)};
+    if (!writeAll(fd, &request, sizeof(request)) || !writeAll(fd, xs, n * sizeof(double)))
+        throw runtime_error("Sending the request failed.");
+
+    ResponseHeader response;
+    if (!readAll(fd, &response, sizeof(response)))
+        throw runtime_error("Reading the response failed.");
+    if (response.status == UNKNOWN_POLYNOMIAL)
+        throw runtime_error("Unknown polynomial.");
+    if (response.status != OK || response.count != n)
+        throw runtime_error("The server refused the request.");
+    if (!readAll(fd, out, n * sizeof(double)))
+        throw runtime_error("Reading the response failed.");
+}
@@ -0,0 +1,185 @@
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include "../polynomial_stats.h"
+
+namespace polystats
+{
+    namespace
+    {
+        // One block per thread. Only the owning thread writes, so updates are
+        // a relaxed load plus a relaxed store; readers see a consistent value
+        // per counter without any locked instruction on the hot path.
+        struct ThreadBlock
+        {
+            atomic<uint64_t> values[METHOD_COUNT][4];
+            Method current = METHOD_COUNT; // Innermost active method
+
+            ThreadBlock();
+            ~ThreadBlock();
+
+            void add(Method method, int field, uint64_t amount)
+            {
+                atomic<uint64_t> &v = values[method][field];
+                v.store(v.load(memory_order_relaxed) + amount, memory_order_relaxed);
+            }
+        };
+
+        struct Registry
+        {
+            mutex lock;
+            vector<ThreadBlock *> blocks;
+            Snapshot retired; // Totals of threads that have exited
+        };
+
+        Registry &registry()
+        {
+            static Registry *instance = new Registry(); // Outlives thread_local blocks
+            return *instance;
+        }
+
+        void addTo(Counters &c, const atomic<uint64_t> *v)
+        {
+            c.calls += v[0].load(memory_order_relaxed);
+            c.nanoseconds += v[1].load(memory_order_relaxed);
+            c.allocations += v[2].load(memory_order_relaxed);
+            c.bytes += v[3].load(memory_order_relaxed);
+        }
+
+        ThreadBlock::ThreadBlock()
+        {
+            for (auto &method : values)
+                for (auto &v : method)
+                    v.store(0, memory_order_relaxed);
+            Registry &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            r.blocks.push_back(this);
+        }
+
+        ThreadBlock::~ThreadBlock()
+        {
+            Registry &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for (int m = 0; m < METHOD_COUNT; ++m)
+                addTo(r.retired.methods[m], values[m]);
+            r.blocks.erase(find(r.blocks.begin(), r.blocks.end(), this));
+        }
+
+        ThreadBlock &local()
+        {
+            thread_local ThreadBlock block;
+            return block;
+        }
+
+        const char *const NAMES[METHOD_COUNT] = {
+            "constructor", "copy_constructor", "assignment", "add", "subtract", "multiply",
+            "equals", "hash", "output", "degree", "evaluate", "evaluate_with_derivatives",
+            "evaluate_accurate", "evaluate_interval", "plan", "compose", "derivative", "integral",
+            "integral_range",
+            "cached_derivative", "cached_integral", "get_root", "set_coefficients",
+            "get_coefficient"};
+    }
+
+    const char *methodName(Method method)
+    {
+        return method < METHOD_COUNT ? NAMES[method] : "unknown";
+    }
+
+    void record(Method method, uint64_t nanoseconds)
+    {
+        ThreadBlock &block = local();
+        block.add(method, 0, 1);
+        block.add(method, 1, nanoseconds);
+    }
+
+    void recordAllocation(size_t bytes)
+    {
+        ThreadBlock &block = local();
+        if (block.current == METHOD_COUNT)
+            return; // Not inside an instrumented method
+        block.add(block.current, 2, 1);
+        block.add(block.current, 3, bytes);
+    }
+
+    Scope::Scope(Method method) : method(method), start(chrono::steady_clock::now())
+    {
+        ThreadBlock &block = local();
+        outer = block.current;
+        block.current = method;
+    }
+
+    Scope::~Scope()
+    {
+        auto elapsed = chrono::steady_clock::now() - start;
+        record(method, chrono::duration_cast<chrono::nanoseconds>(elapsed).count());
+        local().current = outer;
+    }
+
+    Snapshot snapshot()
+    {
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        Snapshot result = r.retired;
+        for (ThreadBlock *block : r.blocks)
+            for (int m = 0; m < METHOD_COUNT; ++m)
+                addTo(result.methods[m], block->values[m]);
+        return result;
+    }
+
+    void reset()
+    {
+        // Counters are owned by their threads; reset is meant for quiescent
+        // points such as between test cases
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        r.retired = Snapshot();
+        for (ThreadBlock *block : r.blocks)
+            for (auto &method : block->values)
+                for (auto &v : method)
+                    v.store(0, memory_order_relaxed);
+    }
+
+    void writePrometheus(ostream &out, const Snapshot &stats)
+    {
+        struct Metric
+        {
+            const char *name;
+            const char *help;
+            uint64_t Counters::*field;
+        };
+        const Metric metrics[] = {
+            {"polynomial_calls_total", "Calls per Polynomial method.", &Counters::calls},
+            {"polynomial_time_nanoseconds_total", "Inclusive time spent per Polynomial method.", &Counters::nanoseconds},
+            {"polynomial_allocations_total", "Coefficient vectors allocated per Polynomial method.", &Counters::allocations},
+            {"polynomial_allocated_bytes_total", "Bytes of coefficient vectors allocated per Polynomial method.", &Counters::bytes}};
+
+        for (const Metric &metric : metrics)
+        {
+            out << "# HELP " << metric.name << " " << metric.help << "\n";
+            out << "# TYPE " << metric.name << " counter\n";
+            for (int m = 0; m < METHOD_COUNT; ++m)
+            {
+                out << metric.name << "{method=\"" << NAMES[m] << "\"} "
+                    << stats.methods[m].*metric.field << "\n";
+            }
+        }
+    }
+
+    bool dumpPrometheus(const string &path)
+    {
+        // Write to a temporary file and rename so scrapers never see a partial file
+        string temp = path + ".tmp";
+        {
+            ofstream out(temp);
+            if (!out)
+                return false;
+            writePrometheus(out, snapshot());
+            if (!out)
+                return false;
+        }
+        return rename(temp.c_str(), path.c_str()) == 0;
+    }
+}
@@ -0,0 +1,299 @@
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../polynomial_tasks.h"
+
+namespace polytasks
+{
+    namespace
+    {
+        struct Task
+        {
+            function<void()> run;
+            TaskGroup *group;
+        };
+
+        struct Queue
+        {
+            mutex lock;
+            deque<Task> tasks;
+        };
+
+        class Scheduler
+        {
+        private:
+            // One queue per background worker plus a last one shared by
+            // threads outside the pool
+            vector<unique_ptr<Queue>> queues;
+            vector<thread> threads;
+            atomic<size_t> queued{0};
+            atomic<bool> stopping{false};
+            mutex sleepLock;
+            condition_variable wake;
+
+            static thread_local Scheduler *owner;
+            static thread_local size_t self;
+
+            size_t home() const
+            {
+                return owner == this ? self : queues.size() - 1;
+            }
+
+            bool take(Task &task)
+            {
+                // Own queue from the back (most recent, still in cache) ...
+                size_t mine = home();
+                {
+                    Queue &q = *queues[mine];
+                    lock_guard<mutex> guard(q.lock);
+                    if (!q.tasks.empty())
+                    {
+                        task = move(q.tasks.back());
+                        q.tasks.pop_back();
+                        queued.fetch_sub(1, memory_order_relaxed);
+                        return true;
+                    }
+                }
+                // ... then the oldest task of anyone else
+                for (size_t k = 1; k < queues.size(); ++k)
+                {
+                    Queue &q = *queues[(mine + k) % queues.size()];
+                    lock_guard<mutex> guard(q.lock);
+                    if (!q.tasks.empty())
+                    {
+                        task = move(q.tasks.front());
+                        q.tasks.pop_front();
+                        queued.fetch_sub(1, memory_order_relaxed);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void workerLoop(size_t index)
+            {
+                owner = this;
+                self = index;
+                Task task;
+                while (!stopping.load(memory_order_acquire))
+                {
+                    if (take(task))
+                    {
+                        execute(task);
+                        continue;
+                    }
+                    unique_lock<mutex> guard(sleepLock);
+                    wake.wait(guard, [&]()
+                              { return stopping.load(memory_order_acquire) || queued.load(memory_order_acquire) > 0; });
+                }
+            }
+
+        public:
+            explicit Scheduler(unsigned workers)
+            {
+                size_t background = workers > 1 ? workers - 1 : 0;
+                for (size_t i = 0; i <= background; ++i)
+                {
+                    queues.push_back(make_unique<Queue>());
+                }
+                for (size_t i = 0; i < background; ++i)
+                {
+                    threads.emplace_back(&Scheduler::workerLoop, this, i);
+                }
+            }
+
+            ~Scheduler()
+            {
+                {
+                    lock_guard<mutex> guard(sleepLock);
+                    stopping.store(true, memory_order_release);
+                }
+                wake.notify_all();
+                for (thread &t : threads)
+                {
+                    t.join();
+                }
+            }
+
+            void push(Task task)
+            {
+                Queue &q = *queues[home()];
+                {
+                    lock_guard<mutex> guard(q.lock);
+                    q.tasks.push_back(move(task));
+                }
+                queued.fetch_add(1, memory_order_release);
+                if (!threads.empty())
+                {
+                    lock_guard<mutex> guard(sleepLock);
+                    wake.notify_one();
+                }
+            }
+
+            // Run one queued task on the calling thread, if there is any
+            bool helpOnce()
+            {
+                Task task;
+                if (!take(task))
+                    return false;
+                execute(task);
+                return true;
+            }
+
+            static void execute(Task &task)
+            {
+                exception_ptr failure;
+                try
+                {
+                    task.run();
+                }
+                catch (...)
+                {
+                    failure = current_exception();
+                }
+                task.run = nullptr;
+                task.group->finish(failure);
+            }
+        };
+
+        thread_local Scheduler *Scheduler::owner = nullptr;
+        thread_local size_t Scheduler::self = 0;
+
+        struct Config
+        {
+            mutex lock;
+            atomic<unsigned> workers{max(1u, thread::hardware_concurrency())};
+            atomic<size_t> grain{1 << 15};
+            atomic<bool> deterministic{false};
+            unique_ptr<Scheduler> scheduler;
+            atomic<Scheduler *> current{nullptr}; // Lock-free read of scheduler
+            atomic<size_t> activeGroups{0};       // Task groups alive; each may hold the scheduler
+        };
+
+        Config &config()
+        {
+            static Config instance;
+            return instance;
+        }
+
+        Scheduler &scheduler()
+        {
+            Config &c = config();
+            Scheduler *s = c.current.load(memory_order_acquire);
+            if (s)
+                return *s;
+            lock_guard<mutex> guard(c.lock);
+            if (!c.scheduler)
+            {
+                c.scheduler = make_unique<Scheduler>(c.workers.load(memory_order_relaxed));
+                c.current.store(c.scheduler.get(), memory_order_release);
+            }
+            return *c.scheduler;
+        }
+    }
+
+    void setWorkerCount(unsigned count)
+    {
+        Config &c = config();
+        lock_guard<mutex> guard(c.lock);
+        // Unpublish first: a group created from here on blocks on the lock
+        // in scheduler(). Paired with the order in TaskGroup(), either this
+        // sees the group or the group sees nullptr.
+        Scheduler *previous = c.current.exchange(nullptr, memory_order_seq_cst);
+        if (c.activeGroups.load(memory_order_seq_cst) > 0)
+        {
+            c.current.store(previous, memory_order_release);
+            throw logic_error("Cannot change the worker count while tasks are running.");
+        }
+        c.workers.store(max(1u, count), memory_order_relaxed);
+        c.scheduler.reset(); // Started again on first use
+    }
+
+    unsigned workerCount()
+    {
+        return config().workers.load(memory_order_relaxed);
+    }
+
+    void setGrainSize(size_t multiplyAdds)
+    {
+        config().grain.store(max<size_t>(multiplyAdds, 1), memory_order_relaxed);
+    }
+
+    size_t grainSize()
+    {
+        return config().grain.load(memory_order_relaxed);
+    }
+
+    void setDeterministic(bool on)
+    {
+        config().deterministic.store(on, memory_order_relaxed);
+    }
+
+    bool deterministic()
+    {
+        return config().deterministic.load(memory_order_relaxed);
+    }
+
+    size_t effectiveGrain(size_t totalWork)
+    {
+        size_t grain = grainSize();
+        if (deterministic() || totalWork <= grain)
+            return grain;
+        // No more than about four tasks per worker, so large jobs do not pay
+        // for more tasks than can run at once
+        size_t share = totalWork / (4 * static_cast<size_t>(workerCount()));
+        return max(grain, share);
+    }
+
+    TaskGroup::TaskGroup()
+    {
+        config().activeGroups.fetch_add(1, memory_order_seq_cst);
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        wait();
+        config().activeGroups.fetch_sub(1, memory_order_release);
+    }
+
+    void TaskGroup::spawn(function<void()> task)
+    {
+        pending.fetch_add(1, memory_order_relaxed);
+        scheduler().push({move(task), this});
+    }
+
+    void TaskGroup::wait()
+    {
+        while (pending.load(memory_order_acquire) > 0)
+        {
+            if (!scheduler().helpOnce())
+                this_thread::yield();
+        }
+    }
+
+    void TaskGroup::sync()
+    {
+        wait();
+        lock_guard<mutex> guard(errorLock);
+        if (error)
+        {
+            exception_ptr failure = error;
+            error = nullptr;
+            rethrow_exception(failure);
+        }
+    }
+
+    void TaskGroup::finish(exception_ptr failure)
+    {
+        if (failure)
+        {
+            lock_guard<mutex> guard(errorLock);
+            if (!error)
+                error = failure;
+        }
+        pending.fetch_sub(1, memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../polynomial_trace.h"
+
+namespace polytrace
+{
+    namespace
+    {
+        struct Event
+        {
+            const char *name;
+            const char *argName[2];
+            int64_t argValue[2];
+            uint64_t start;    // Nanoseconds since the process started tracing
+            uint64_t duration; // Nanoseconds
+        };
+
+        // Single-writer ring. Each slot carries a sequence number that the
+        // writer bumps after filling it, so flush() can skip a slot that was
+        // being overwritten while it was read.
+        struct Slot
+        {
+            atomic<uint64_t> sequence{0};
+            Event event;
+        };
+
+        struct Ring
+        {
+            vector<Slot> slots;
+            atomic<uint64_t> written{0}; // Total spans ever written
+            uint32_t tid;
+
+            Ring(size_t capacity, uint32_t tid) : slots(capacity), tid(tid) {}
+
+            void push(const Event &event)
+            {
+                uint64_t n = written.load(memory_order_relaxed);
+                Slot &slot = slots[n % slots.size()];
+                slot.sequence.store(0, memory_order_relaxed);
+                atomic_thread_fence(memory_order_release);
+                slot.event = event;
+                slot.sequence.store(n + 1, memory_order_release);
+                written.store(n + 1, memory_order_release);
+            }
+        };
+
+        struct Registry
+        {
+            mutex lock;
+            vector<unique_ptr<Ring>> rings; // Kept after their thread exits
+            vector<Ring *> idle;            // Rings whose thread exited, reused by new threads
+            size_t capacity = 1 << 14;
+            uint32_t nextTid = 1;
+            chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+        };
+
+        Registry &registry()
+        {
+            static Registry *instance = new Registry();
+            return *instance;
+        }
+
+        // Hands the thread a ring, preferring one left by an exited thread so
+        // memory stays bounded by the number of threads alive at once. The
+        // spans already in a reused ring are kept and flushed under its tid.
+        Ring *acquire()
+        {
+            Registry &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for (size_t i = 0; i < r.idle.size(); ++i)
+            {
+                if (r.idle[i]->slots.size() == r.capacity)
+                {
+                    Ring *ring = r.idle[i];
+                    r.idle.erase(r.idle.begin() + i);
+                    return ring;
+                }
+            }
+            r.rings.push_back(make_unique<Ring>(r.capacity, r.nextTid++));
+            return r.rings.back().get();
+        }
+
+        // Returns the thread's ring to the idle list when the thread exits
+        struct Owner
+        {
+            Ring *ring = nullptr;
+
+            ~Owner()
+            {
+                if (ring == nullptr)
+                    return;
+                Registry &r = registry();
+                lock_guard<mutex> guard(r.lock);
+                r.idle.push_back(ring);
+            }
+        };
+
+        Ring &local()
+        {
+            thread_local Owner owner;
+            if (owner.ring == nullptr)
+                owner.ring = acquire();
+            return *owner.ring;
+        }
+
+        uint64_t now()
+        {
+            auto elapsed = chrono::steady_clock::now() - registry().origin;
+            return chrono::duration_cast<chrono::nanoseconds>(elapsed).count();
+        }
+    }
+
+    void setCapacity(size_t spansPerThread)
+    {
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        r.capacity = max<size_t>(spansPerThread, 1);
+    }
+
+    Span::Span(const char *name, const char *argName0, int64_t arg0, const char *argName1, int64_t arg1)
+        : name(name), argName{argName0, argName1}, argValue{arg0, arg1}
+    {
+        local(); // Claim the ring before the span starts so it lies within this thread's ownership
+        start = now();
+    }
+
+    Span::~Span()
+    {
+        Event event{name, {argName[0], argName[1]}, {argValue[0], argValue[1]}, start, now() - start};
+        local().push(event);
+    }
+
+    bool flush(const string &path)
+    {
+        string temp = path + ".tmp";
+        {
+            ofstream out(temp);
+            if (!out)
+                return false;
+
+            out << fixed << setprecision(3); // Microsecond timestamps with ns resolution
+            out << "{\"traceEvents\": [";
+            bool first = true;
+            Registry &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for (const unique_ptr<Ring> &ring : r.rings)
+            {
+                uint64_t written = ring->written.load(memory_order_acquire);
+                uint64_t begin = written > ring->slots.size() ? written - ring->slots.size() : 0;
+                for (uint64_t n = begin; n < written; ++n)
+                {
+                    const Slot &slot = ring->slots[n % ring->slots.size()];
+                    if (slot.sequence.load(memory_order_acquire) != n + 1)
+                        continue;
+                    Event event = slot.event;
+                    atomic_thread_fence(memory_order_acquire);
+                    if (slot.sequence.load(memory_order_relaxed) != n + 1)
+                        continue; // Overwritten while copying
+
+                    out << (first ? "\n" : ",\n");
+                    first = false;
+                    out << "{\"name\": \"" << event.name << "\", \"cat\": \"polynomial\", \"ph\": \"X\", \"pid\": 1"
+                        << ", \"tid\": " << ring->tid << ", \"ts\": " << event.start / 1000.0
+                        << ", \"dur\": " << event.duration / 1000.0 << ", \"args\": {";
+                    for (int a = 0; a < 2 && event.argName[a]; ++a)
+                    {
+                        out << (a ? ", " : "") << "\"" << event.argName[a] << "\": " << event.argValue[a];
+                    }
+                    out << "}}";
+                }
+            }
+            out << "\n]}\n";
+            if (!out)
+                return false;
+        }
+        return rename(temp.c_str(), path.c_str()) == 0;
+    }
+
+    void clear()
+    {
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        // Idle rings of an old capacity would never be handed out again
+        auto stale = [&](const Ring *ring)
+        { return ring->slots.size() != r.capacity; };
+        for (Ring *ring : r.idle)
+        {
+            if (stale(ring))
+                r.rings.erase(find_if(r.rings.begin(), r.rings.end(), [&](const unique_ptr<Ring> &owned)
+                                      { return owned.get() == ring; }));
+        }
+        r.idle.erase(remove_if(r.idle.begin(), r.idle.end(), stale), r.idle.end());
+
+        for (const unique_ptr<Ring> &ring : r.rings)
+        {
+            for (Slot &slot : ring->slots)
+                slot.sequence.store(0, memory_order_relaxed);
+        }
+    }
+
+    size_t ringCount()
+    {
+        Registry &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        return r.rings.size();
+    }
+}
@@ -0,0 +1,316 @@
+#include <stdexcept>
+#include "../polynomial_view.h"
+#include "../polynomial_tasks.h"
+#include "../polynomial_dispatch.h"
+
+static void checkCapacity(span<double> out, size_t needed)
+{
+    if (out.size() < needed)
+        throw invalid_argument("Output span is too small.");
+}
+
+// Constructors
+PolynomialView::PolynomialView() {}
+
+PolynomialView::PolynomialView(span<const double> coefficients) : coeffs(coefficients) {}
+
+// Arithmetic into caller-provided storage
+size_t PolynomialView::add(PolynomialView a, PolynomialView b, span<double> out)
+{
+    size_t n = max(a.coeffs.size(), b.coeffs.size());
+    checkCapacity(out, n);
+    polydispatch::kernels().add(a.coeffs.data(), a.coeffs.size(), b.coeffs.data(), b.coeffs.size(), out.data());
+    return n;
+}
+
+size_t PolynomialView::subtract(PolynomialView a, PolynomialView b, span<double> out)
+{
+    size_t n = max(a.coeffs.size(), b.coeffs.size());
+    checkCapacity(out, n);
+    polydispatch::kernels().subtract(a.coeffs.data(), a.coeffs.size(), b.coeffs.data(), b.coeffs.size(), out.data());
+    return n;
+}
+
+// out[o0, o1) of a * b. Each coefficient is summed over i in ascending order
+// however the output is blocked, so blocked and serial results are identical.
+static void multiplyBlock(span<const double> a, span<const double> b, span<double> out, size_t o0, size_t o1)
+{
+    polydispatch::kernels().multiplyBlock(a.data(), a.size(), b.data(), b.size(), out.data(), o0, o1);
+}
+
+size_t PolynomialView::multiply(PolynomialView a, PolynomialView b, span<double> out)
+{
+    if (a.coeffs.empty() || b.coeffs.empty())
+        return 0;
+
+    size_t n = a.coeffs.size() + b.coeffs.size() - 1;
+    checkCapacity(out, n);
+
+    size_t work = a.coeffs.size() * b.coeffs.size();
+    size_t grain = polytasks::effectiveGrain(work);
+    if (work < 2 * grain || polytasks::workerCount() == 1)
+    {
+        multiplyBlock(a.coeffs, b.coeffs, out, 0, n);
+        return n;
+    }
+
+    // An output coefficient takes at most min(|a|, |b|) multiply-adds
+    size_t block = max<size_t>(1, grain / min(a.coeffs.size(), b.coeffs.size()));
+    polytasks::TaskGroup group;
+    for (size_t o0 = 0; o0 < n; o0 += block)
+    {
+        size_t o1 = min(n, o0 + block);
+        group.spawn([=]()
+                    { multiplyBlock(a.coeffs, b.coeffs, out, o0, o1); });
+    }
+    group.sync();
+    return n;
+}
+
+namespace
+{
+    // Divide-and-conquer composition: for a coefficient range of width w split
+    // at the largest power of two h < w, p_lo..hi(q) = L(q) + q^h H(q). The two
+    // halves run as separate tasks and the squares q^(2^k) are shared.
+    struct Composer
+    {
+        span<const double> p;
+        span<const double> q;
+        size_t m;                     // Degree of q
+        size_t leafWidth;             // Ranges this narrow use plain Horner
+        vector<vector<double>> power; // power[k] = q^(2^k)
+
+        static vector<double> multiply(span<const double> a, span<const double> b)
+        {
+            vector<double> out(a.size() + b.size() - 1);
+            PolynomialView::multiply(a, b, out);
+            return out;
+        }
+
+        vector<double> horner(size_t lo, size_t hi) const
+        {
+            vector<double> result(1, p[hi - 1]);
+            for (size_t i = hi - 1; i-- > lo;)
+            {
+                result = multiply(result, q);
+                result[0] += p[i];
+            }
+            return result;
+        }
+
+        vector<double> run(size_t lo, size_t hi) const
+        {
+            size_t w = hi - lo;
+            if (w <= leafWidth)
+                return horner(lo, hi);
+
+            size_t h = 1, k = 0;
+            while (h * 2 < w)
+            {
+                h *= 2;
+                ++k;
+            }
+
+            vector<double> low;
+            polytasks::TaskGroup group;
+            group.spawn([&]()
+                        { low = run(lo, lo + h); });
+            vector<double> high = run(lo + h, hi);
+            group.sync();
+
+            vector<double> result = multiply(power[k], high);
+            for (size_t i = 0; i < low.size(); ++i)
+            {
+                result[i] += low[i];
+            }
+            return result;
+        }
+    };
+}
+
+size_t PolynomialView::compose(PolynomialView p, PolynomialView q, span<double> out)
+{
+    if (p.coeffs.empty())
+        return 0;
+
+    static const double zero = 0.0;
+    span<const double> inner = q.coeffs.empty() ? span<const double>(&zero, 1) : q.coeffs;
+    size_t m = inner.size() - 1;
+    size_t n = (p.coeffs.size() - 1) * m + 1;
+    checkCapacity(out, n);
+
+    // Horner over w coefficients costs about (w m)^2 / 2 multiply-adds
+    size_t width = p.coeffs.size();
+    size_t work = width * width * max<size_t>(m, 1) * max<size_t>(m, 1) / 2;
+    size_t grain = polytasks::effectiveGrain(work);
+    size_t leafWidth = static_cast<size_t>(sqrt(2.0 * grain)) / max<size_t>(m, 1);
+    // Small jobs use plain Horner without tasks. This check does not depend on
+    // the worker count, so deterministic results stay independent of it.
+    if (work <= grain)
+        leafWidth = width;
+
+    Composer composer{p.coeffs, inner, m, max<size_t>(leafWidth, 2), {}};
+    if (width > composer.leafWidth)
+    {
+        composer.power.push_back(vector<double>(inner.begin(), inner.end()));
+        for (size_t h = 2; h < width; h *= 2)
+        {
+            composer.power.push_back(Composer::multiply(composer.power.back(), composer.power.back()));
+        }
+    }
+
+    vector<double> result = composer.run(0, width);
+    copy(result.begin(), result.end(), out.begin());
+    return n;
+}
+
+size_t PolynomialView::derivative(PolynomialView p, span<double> out)
+{
+    if (p.coeffs.size() <= 1)
+        return 0;
+
+    size_t n = p.coeffs.size() - 1;
+    checkCapacity(out, n);
+    for (size_t i = 1; i < p.coeffs.size(); ++i)
+    {
+        out[i - 1] = p.coeffs[i] * i;
+    }
+    return n;
+}
+
+size_t PolynomialView::integral(PolynomialView p, span<double> out)
+{
+    size_t n = p.coeffs.size() + 1;
+    checkCapacity(out, n);
+    out[0] = 0.0;
+    for (size_t i = 0; i < p.coeffs.size(); ++i)
+    {
+        out[i + 1] = p.coeffs[i] / (i + 1);
+    }
+    return n;
+}
+
+// Utility functions
+int PolynomialView::degree() const
+{
+    return static_cast<int>(coeffs.size()) - 1;
+}
+
+size_t PolynomialView::size() const
+{
+    return coeffs.size();
+}
+
+double PolynomialView::evaluate(double x) const
+{
+    double result = 0.0;
+    for (int i = degree(); i >= 0; --i)
+    {
+        result = result * x + coeffs[i];
+    }
+    return result;
+}
+
+void PolynomialView::evaluate(const double *xs, double *out, size_t n) const
+{
+    polydispatch::kernels().evaluate(coeffs.data(), coeffs.size(), xs, out, n);
+}
+
+double PolynomialView::evaluateAccurate(double x, double *errorBound) const
+{
+    double result;
+    polydispatch::kernels().evaluateAccurate(coeffs.data(), coeffs.size(), &x, &result, errorBound, 1);
+    return result;
+}
+
+void PolynomialView::evaluateAccurate(const double *xs, double *out, size_t n, double *errorBounds) const
+{
+    polydispatch::kernels().evaluateAccurate(coeffs.data(), coeffs.size(), xs, out, errorBounds, n);
+}
+
+void PolynomialView::evaluateWithDerivatives(double x, int k, double *out) const
+{
+    // Extended Horner: out[j] accumulates p^(j)(x) / j!
+    for (int j = 0; j <= k; ++j)
+    {
+        out[j] = 0.0;
+    }
+    int n = degree();
+    for (int i = n; i >= 0; --i)
+    {
+        for (int j = min(k, n - i); j >= 1; --j)
+        {
+            out[j] = out[j] * x + out[j - 1];
+        }
+        out[0] = out[0] * x + coeffs[i];
+    }
+    double factorial = 1.0;
+    for (int j = 2; j <= k; ++j)
+    {
+        factorial *= j;
+        out[j] *= factorial;
+    }
+}
+
+Polynomial PolynomialView::derivative() const
+{
+    if (coeffs.size() <= 1)
+        return Polynomial();
+
+    vector<double> result(coeffs.size() - 1);
+    derivative(*this, result);
+    return Polynomial(result);
+}
+
+Polynomial PolynomialView::integral() const
+{
+    vector<double> result(coeffs.size() + 1);
+    integral(*this, result);
+    return Polynomial(result);
+}
+
+double PolynomialView::integral(double x1, double x2) const
+{
+    // Horner on the antiderivative without materializing it
+    double upper = 0.0, lower = 0.0;
+    for (int i = degree(); i >= 0; --i)
+    {
+        double c = coeffs[i] / (i + 1);
+        upper = (upper + c) * x2;
+        lower = (lower + c) * x1;
+    }
+    return upper - lower;
+}
+
+double PolynomialView::getRoot(double guess, double tolerance, int maxIter) const
+{
+    double x = guess;
+    double values[2];
+    for (int i = 0; i < maxIter; ++i)
+    {
+        evaluateWithDerivatives(x, 1, values);
+        if (abs(values[0]) < tolerance)
+            return x;
+        if (values[1] == 0)
+            break; // Avoid division by zero
+        x -= values[0] / values[1];
+    }
+    return x; // Return the result after maxIter iterations
+}
+
+double PolynomialView::getCoefficient(int degree) const
+{
+    if (degree < 0 || degree >= static_cast<int>(coeffs.size()))
+        return 0.0;
+    return coeffs[degree];
+}
+
+Polynomial PolynomialView::toPolynomial() const
+{
+    return Polynomial(vector<double>(coeffs.begin(), coeffs.end()));
+}
+
+span<const double> PolynomialView::coefficients() const
+{
+    return coeffs;
+}
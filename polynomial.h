@@ -5,15 +5,51 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 
 using namespace std;
 
+class PolynomialView;
+
 class Polynomial
 {
+public:
+    // Precomputed form of a fixed polynomial for repeated evaluation.
+    // Uses Paterson-Stockmeyer splitting: the coefficients are grouped into
+    // blocks of size k ~ sqrt(n), the powers x^0..x^k are formed once per point
+    // and the blocks are combined with a Horner pass in x^k. The multiply count
+    // stays about n, but the dependent chain drops to about 2 sqrt(n); bench
+    // rows evaluate_plan* show the gain from about degree 100, while at low
+    // degree plain evaluate is as fast.
+    class Plan
+    {
+    private:
+        vector<double> coeffs; // Coefficients padded to a whole number of blocks
+        int blockSize;         // Number of coefficients per block
+        int realDegree;        // Degree of the planned polynomial
+
+    public:
+        static constexpr int MAX_BLOCK = 32;
+
+        Plan();
+        explicit Plan(const vector<double> &coefficients);
+
+        int degree() const;                                  // Degree of the planned polynomial
+        double evaluate(double x) const;                     // Evaluate at a single point
+        void evaluate(const double *xs, double *out, size_t n) const; // Evaluate at n points
+    };
+
 private:
     vector<double> coeffs; // Store coefficients of the polynomial
     void trim();
 
+    // Lazily built derivative and antiderivative, published once with a
+    // compare-and-swap so concurrent const readers are safe. Cleared whenever
+    // the coefficients change.
+    mutable atomic<Polynomial *> derivativeCache;
+    mutable atomic<Polynomial *> integralCache;
+    void clearCaches();
+
 public:
     // Constructors
     Polynomial();
@@ -33,21 +69,49 @@ public:
 
     // Equality operator
     bool operator==(const Polynomial &other) const;
+    bool equals(const Polynomial &other, double tolerance = 0) const; // Ignores trailing zeros
+    size_t hash() const;                                               // Consistent with == and equals() at tolerance 0 only
 
     // Output operator
     friend ostream &operator<<(ostream &out, const Polynomial &poly);
 
+    // Non-owning view of the coefficients, valid until the next change
+    operator PolynomialView() const;
+
     // Utility functions
     int degree() const;                            // Return the degree of the polynomial
     double evaluate(double x) const;               // Evaluate the polynomial at x
+    Plan plan() const;                             // Precompute a plan for repeated evaluation
+    void evaluateWithDerivatives(double x, int k, double *out) const; // out[j] = p^(j)(x) for j = 0..k
+    void evaluateWithDerivatives(const double *xs, size_t n, int k, double *out) const; // Row i holds point xs[i]
+    // Compensated Horner: about twice the working precision for 2-3 times the
+    // cost of evaluate. If errorBound is given it receives a bound on the
+    // absolute error, so callers can escalate only when it is too loose.
+    double evaluateAccurate(double x, double *errorBound = nullptr) const;
+    void evaluateAccurate(const double *xs, double *out, size_t n, double *errorBounds = nullptr) const;
+    // Guaranteed bounds [outLo, outHi] on p(x) for every x in [lo, hi]
+    // (lo <= hi), for pruning in branch-and-bound searches
+    void evaluateInterval(double lo, double hi, double &outLo, double &outHi) const;
+    void evaluateInterval(const double *los, const double *his, double *outLo, double *outHi, size_t n) const;
     Polynomial compose(const Polynomial &q) const; // Composition
     Polynomial derivative() const;                 // Derivative of the polynomial
     Polynomial integral() const;                   // Return a polynomial of integration
     double integral(double x1, double x2) const;   // Intergate from x1 to x2
+    const Polynomial &cachedDerivative() const;    // Derivative built once, valid until the next change
+    const Polynomial &cachedIntegral() const;      // Antiderivative built once, valid until the next change
     double getRoot(double guess = 1, double tolerance = 1e-6, int maxIter = 100);
     void setCoefficients(const vector<double> &coefficients);
     // Set coefficients
     double getCoefficient(int degree) const;
     // Get coefficient of a specific degree
 };
+
+namespace std
+{
+    template <>
+    struct hash<Polynomial>
+    {
+        size_t operator()(const Polynomial &poly) const { return poly.hash(); }
+    };
+}
 #endif // POLYNOMIAL_H
\ No newline at end of file
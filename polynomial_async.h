@@ -0,0 +1,60 @@
+#ifndef POLYNOMIAL_ASYNC_H
+#define POLYNOMIAL_ASYNC_H
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include "polynomial.h"
+
+// Future-returning versions of the heavy operations. Calls are queued on a
+// library-owned pool of threads; operands are copied, so the caller may drop
+// them right away. The queue is bounded: submitting to a full queue throws
+// QueueFull instead of letting a backlog grow without limit.
+
+namespace polyasync
+{
+    // Thrown by submit when maxQueued calls are already waiting
+    class QueueFull : public runtime_error
+    {
+    public:
+        QueueFull() : runtime_error("Polynomial async queue is full.") {}
+    };
+
+    // Stored in the future of a call cancelled before it finished
+    class Cancelled : public runtime_error
+    {
+    public:
+        Cancelled() : runtime_error("Polynomial async call was cancelled.") {}
+    };
+
+    // Shared flag checked before a call starts and between chunks of batched
+    // work. Copies refer to the same flag.
+    class CancellationToken
+    {
+    private:
+        shared_ptr<atomic<bool>> flag;
+
+    public:
+        CancellationToken();
+        void cancel() const;
+        bool cancelled() const;
+    };
+
+    // Replace the pool; calls already queued on the old pool finish first.
+    // Not safe while other threads are submitting.
+    void configure(unsigned threads, size_t maxQueued = 1024);
+    size_t queued(); // Calls waiting for a thread
+
+    future<Polynomial> multiplyAsync(const Polynomial &a, const Polynomial &b, CancellationToken token = {});
+    future<Polynomial> composeAsync(const Polynomial &p, const Polynomial &q, CancellationToken token = {});
+
+    // One Newton root per starting guess
+    future<vector<double>> rootsAsync(const Polynomial &p, vector<double> guesses, double tolerance = 1e-6,
+                                      int maxIter = 100, CancellationToken token = {});
+
+    // p evaluated at every point of xs through p.plan()
+    future<vector<double>> evaluateAsync(const Polynomial &p, vector<double> xs, CancellationToken token = {});
+}
+
+#endif // POLYNOMIAL_ASYNC_H
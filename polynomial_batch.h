@@ -0,0 +1,38 @@
+#ifndef POLYNOMIAL_BATCH_H
+#define POLYNOMIAL_BATCH_H
+
+#include "polynomial.h"
+
+// A set of polynomials of equal degree stored coefficient-major (SoA):
+// coefficient k of every polynomial is contiguous, so the loops below run
+// across polynomials and vectorize.
+class PolynomialBatch
+{
+private:
+    vector<double> coeffs; // coeffs[k * count + i] is coefficient k of polynomial i
+    size_t count;          // Number of polynomials
+    int deg;               // Shared degree
+
+public:
+    // Constructors
+    PolynomialBatch();
+    PolynomialBatch(size_t count, int degree); // count zero polynomials
+    PolynomialBatch(const vector<Polynomial> &polys);
+
+    // Arithmetic operators (element-wise over the set)
+    PolynomialBatch operator+(const PolynomialBatch &other) const;
+    PolynomialBatch operator-(const PolynomialBatch &other) const;
+    PolynomialBatch operator*(const PolynomialBatch &other) const;
+
+    // Utility functions
+    size_t size() const;                                    // Number of polynomials
+    int degree() const;                                     // Shared degree
+    void evaluate(const double *xs, double *out) const;     // out[i] = p_i(xs[i])
+    void evaluate(double x, double *out) const;             // out[i] = p_i(x)
+    PolynomialBatch derivative() const;                     // Derivative of every polynomial
+    Polynomial get(size_t index) const;                     // Copy one polynomial out; throws out_of_range
+    double getCoefficient(size_t index, int degree) const;
+    void setCoefficient(size_t index, int degree, double value);
+};
+
+#endif // POLYNOMIAL_BATCH_H
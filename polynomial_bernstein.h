@@ -0,0 +1,51 @@
+#ifndef POLYNOMIAL_BERNSTEIN_H
+#define POLYNOMIAL_BERNSTEIN_H
+
+#include <span>
+#include "polynomial.h"
+
+// A polynomial on [a, b] in the Bernstein basis:
+//   p(x) = sum b_i C(n, i) t^i (1 - t)^(n - i),  t = (x - a) / (b - a)
+// The graph lies in the convex hull of the control points (a + i (b - a) / n,
+// b_i), so the smallest and largest coefficient bound p on [a, b], and
+// de Casteljau subdivision splits the interval with well-conditioned steps.
+class BernsteinPolynomial
+{
+private:
+    vector<double> coeffs; // b_0..b_n
+    double a, b;           // Interval the basis is defined on
+
+public:
+    // Constructors
+    BernsteinPolynomial(); // Zero on [0, 1]
+    BernsteinPolynomial(const vector<double> &coefficients, double a = 0, double b = 1);
+    // From the monomial basis, O(n^2). There is no sub-quadratic conversion:
+    // the FFT-based Taylor shift it would need loses accuracy in doubles.
+    explicit BernsteinPolynomial(const Polynomial &p, double a = 0, double b = 1);
+
+    // In-place de Casteljau subdivision of coefficients over [0, 1] at t:
+    // coeffs becomes the piece over [0, t], right receives [t, 1]
+    static void subdivide(span<double> coeffs, double t, span<double> right);
+
+    // Utility functions
+    Polynomial toPolynomial() const; // Back to the monomial basis, O(n^2)
+    int degree() const;
+    double lower() const;
+    double upper() const;
+    const vector<double> &coefficients() const;
+    double evaluate(double x) const;             // O(n) and stable for x in [a, b]
+    void bounds(double &lo, double &hi) const;   // Convex-hull bounds of p on [a, b]
+    void elevate();                              // Same polynomial, one degree higher
+    // Split at x: this keeps [a, x] and right becomes [x, b]. Does not
+    // allocate when right already has room for degree() + 1 coefficients.
+    void subdivide(double x, BernsteinPolynomial &right);
+    // Real roots in [a, b] by Bezier clipping; pieces that are split are
+    // searched in parallel on the task pool. Each root is reported once,
+    // whatever its multiplicity. Roots of odd multiplicity are found where
+    // the sign changes. Tangent (even-multiplicity) roots are found as roots
+    // of the derivative where |p| <= tolerance * max |b_i|, so a near-tangent
+    // minimum that close to zero is reported as a root too.
+    vector<double> roots(double tolerance = 1e-12) const;
+};
+
+#endif // POLYNOMIAL_BERNSTEIN_H
@@ -0,0 +1,61 @@
+#ifndef POLYNOMIAL_CACHE_H
+#define POLYNOMIAL_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "polynomial.h"
+
+// Opt-in memoization of expensive Polynomial operations.
+// Entries are keyed on the operation and the operand hashes, and the operands
+// are kept alongside the result so a hash collision never returns a wrong
+// answer. The cache is split into shards, each with its own lock and LRU list,
+// so threads working on different operands rarely contend.
+class PolynomialCache
+{
+private:
+    enum Operation
+    {
+        MULTIPLY,
+        COMPOSE,
+        DERIVATIVE
+    };
+
+    struct Entry
+    {
+        Operation op;
+        Polynomial a, b;
+        size_t key;
+        Polynomial result;
+    };
+
+    struct Shard
+    {
+        mutable mutex lock;
+        list<Entry> entries; // Most recently used first
+        unordered_multimap<size_t, list<Entry>::iterator> index;
+        size_t hits = 0;     // Counted per shard under its lock, summed on read
+        size_t misses = 0;
+    };
+
+    vector<Shard> shards;
+    size_t shardCapacity;
+
+    template <typename Compute>
+    Polynomial lookup(Operation op, const Polynomial &a, const Polynomial &b, Compute compute);
+
+public:
+    // capacity is the total number of cached results across all shards
+    explicit PolynomialCache(size_t capacity = 1024, size_t shardCount = 16);
+
+    Polynomial multiply(const Polynomial &a, const Polynomial &b); // a * b
+    Polynomial compose(const Polynomial &p, const Polynomial &q);  // p.compose(q)
+    Polynomial derivative(const Polynomial &p);                     // p.derivative()
+
+    size_t hitCount() const;
+    size_t missCount() const;
+    size_t size() const; // Number of cached results
+    void clear();        // Drop all entries and reset the counters
+};
+
+#endif // POLYNOMIAL_CACHE_H
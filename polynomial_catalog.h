@@ -0,0 +1,69 @@
+#ifndef POLYNOMIAL_CATALOG_H
+#define POLYNOMIAL_CATALOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "polynomial.h"
+#include "polynomial_view.h"
+
+// Binary polynomial catalogs.
+//
+// Layout (all integers and doubles little-endian):
+//   header  64 bytes: magic "POLYCAT\0", u32 version, u32 flags, u64 count,
+//                     u64 index offset, u64 file size, zero padding
+//   blocks  one per polynomial, each starting on a 64-byte boundary,
+//           holding its coefficients from x^0 upwards
+//   index   count entries of {u64 block offset, u64 coefficient count}
+//
+// The writer streams blocks and appends the index when it is closed, so a
+// catalog never has to fit in memory. The reader maps the file and hands out
+// views straight into the mapping.
+
+class PolynomialCatalogWriter
+{
+private:
+    FILE *file;
+    uint64_t offset;          // Current end of file
+    vector<uint64_t> index;   // Offset and count pairs
+    string path;
+
+    void writeHeader(uint64_t count, uint64_t indexOffset);
+    void writeBytes(const void *data, size_t size);
+    void pad();
+
+public:
+    static const uint32_t VERSION = 1;
+    static const size_t ALIGNMENT = 64;
+
+    explicit PolynomialCatalogWriter(const string &path);
+    ~PolynomialCatalogWriter();
+
+    PolynomialCatalogWriter(const PolynomialCatalogWriter &) = delete;
+    PolynomialCatalogWriter &operator=(const PolynomialCatalogWriter &) = delete;
+
+    void add(PolynomialView poly); // Polynomial converts implicitly
+    void add(span<const double> coefficients);
+    void close(); // Writes the index and header; called by the destructor if needed
+};
+
+class PolynomialCatalog
+{
+private:
+    const unsigned char *base; // Start of the mapping
+    size_t length;             // Mapped bytes
+    const uint64_t *index;     // Offset and count pairs
+    size_t count;
+
+public:
+    explicit PolynomialCatalog(const string &path);
+    ~PolynomialCatalog();
+
+    PolynomialCatalog(const PolynomialCatalog &) = delete;
+    PolynomialCatalog &operator=(const PolynomialCatalog &) = delete;
+
+    size_t size() const;                          // Number of polynomials
+    PolynomialView operator[](size_t i) const;    // Zero-copy view, valid while the catalog lives
+};
+
+#endif // POLYNOMIAL_CATALOG_H
@@ -0,0 +1,52 @@
+#ifndef POLYNOMIAL_DISPATCH_H
+#define POLYNOMIAL_DISPATCH_H
+
+#include <cstddef>
+
+using namespace std;
+
+// Runtime selection of the vectorized inner loops. Each kernel is compiled
+// once per instruction set and the best one the CPU supports is picked the
+// first time a kernel is used (the library also does this while loading),
+// so one binary runs on every x86-64 machine. Set POLYNOMIAL_ISA to scalar,
+// sse4.2, avx2 or avx512 to force a variant for benchmarking or testing.
+//
+// polynomial_dispatch.cpp is compiled with fp-contract off whatever the build
+// flags, so the AVX-512 variant does not fuse multiplies and adds; all
+// variants then round identically and only their speed differs.
+
+namespace polydispatch
+{
+    enum Isa
+    {
+        SCALAR, // Baseline flags of the build
+        SSE4_2,
+        AVX2,   // With FMA
+        AVX512, // With FMA
+        ISA_COUNT
+    };
+
+    struct Kernels
+    {
+        // out[i] = p(xs[i]) by Horner, p given by coeffs[0..nc)
+        void (*evaluate)(const double *coeffs, size_t nc, const double *xs, double *out, size_t n);
+        // out[o0..o1) of a * b, every coefficient summed in ascending order of a's index
+        void (*multiplyBlock)(const double *a, size_t na, const double *b, size_t nb, double *out, size_t o0, size_t o1);
+        // out[i] = a[i] + b[i] and a[i] - b[i] over max(na, nb), missing terms read as zero
+        void (*add)(const double *a, size_t na, const double *b, size_t nb, double *out);
+        void (*subtract)(const double *a, size_t na, const double *b, size_t nb, double *out);
+        // Compensated Horner; bounds[i], if bounds is not null, bounds |out[i] - p(xs[i])|
+        void (*evaluateAccurate)(const double *coeffs, size_t nc, const double *xs, double *out, double *bounds, size_t n);
+    };
+
+    const Kernels &kernels(); // The selected variant
+    Isa isa();
+    const char *name(Isa isa);
+    bool supported(Isa isa);
+
+    // Force a variant; returns false and keeps the current one if the CPU
+    // lacks it. Meant for tests and benchmarks, not for use mid-computation.
+    bool setIsa(Isa isa);
+}
+
+#endif // POLYNOMIAL_DISPATCH_H
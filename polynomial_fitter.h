@@ -0,0 +1,46 @@
+#ifndef POLYNOMIAL_FITTER_H
+#define POLYNOMIAL_FITTER_H
+
+#include "polynomial.h"
+
+// Streaming least-squares fit of samples (x, y) by polynomials of degree up
+// to maxDegree. Samples are not stored: each one is rotated into an upper
+// triangular factor R of the design matrix with Givens rotations, so memory
+// is O(maxDegree^2) however long the stream. The columns are Chebyshev
+// polynomials on [lower, upper], which keeps R well conditioned where the
+// monomial normal equations would not be. Because the columns are nested, the
+// leading block of R fits every lower degree as well.
+//
+// A fitter is not thread-safe; give each thread its own and merge them.
+class PolynomialFitter
+{
+private:
+    int n;               // Number of basis columns, maxDegree + 1
+    double lower, upper; // Domain of the Chebyshev basis
+    vector<double> R;    // n x n upper triangular, row-major
+    vector<double> qty;  // Q^T y, one entry per column
+    double residualSum;  // Squared residual rotated out of qty
+    size_t samples;
+    vector<double> row;  // Scratch design row
+
+    void rotate(double *r, double rhs); // Fold one weighted row into R and qty
+
+public:
+    // Constructors
+    // Samples outside [lower, upper] are accepted but degrade conditioning
+    explicit PolynomialFitter(int maxDegree, double lower = -1, double upper = 1);
+
+    void add(double x, double y, double weight = 1);
+    void add(const double *xs, const double *ys, size_t count);
+    void merge(const PolynomialFitter &other); // Same degree and domain required
+
+    // Utility functions
+    int maxDegree() const;
+    size_t count() const;
+    // Least-squares polynomial of the given degree (at most maxDegree) for
+    // every sample so far; throws runtime_error if they do not determine it
+    Polynomial fit(int degree) const;
+    double residual(int degree) const; // Weighted sum of squared residuals of fit(degree)
+};
+
+#endif // POLYNOMIAL_FITTER_H
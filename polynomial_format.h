@@ -0,0 +1,38 @@
+#ifndef POLYNOMIAL_FORMAT_H
+#define POLYNOMIAL_FORMAT_H
+
+#include <string>
+#include "polynomial.h"
+#include "polynomial_view.h"
+
+// Formatting options for PolynomialFormatter
+struct PolynomialFormat
+{
+    enum Style
+    {
+        SPACED,  // "3x^2 - 2x + 1"   (chat_gpt backend)
+        COMPACT  // "3x^2-2x^1+1"     (perplexity backend)
+    };
+
+    int precision = -1;     // Significant digits; -1 is the shortest text that round-trips
+    bool ascending = false; // Lowest power first instead of highest
+    Style style = SPACED;
+};
+
+// Text output built on to_chars. Each term is written into a small stack
+// buffer and handed to the destination in one piece, so formatting into a
+// caller buffer never allocates and appending to a string only allocates
+// when the string grows. The zero polynomial is written as "0".
+class PolynomialFormatter
+{
+public:
+    // snprintf-style: writes at most size - 1 characters plus a terminating
+    // '\0' and returns the full length the text needs
+    static size_t format(PolynomialView poly, char *buf, size_t size, const PolynomialFormat &fmt = PolynomialFormat());
+
+    static void appendTo(string &out, PolynomialView poly, const PolynomialFormat &fmt = PolynomialFormat());
+
+    static ostream &write(ostream &out, PolynomialView poly, const PolynomialFormat &fmt = PolynomialFormat());
+};
+
+#endif // POLYNOMIAL_FORMAT_H
@@ -0,0 +1,95 @@
+#ifndef POLYNOMIAL_MULTIVARIATE_H
+#define POLYNOMIAL_MULTIVARIATE_H
+
+#include <cstdint>
+#include "polynomial.h"
+
+// Sparse polynomial in up to MAX_VARIABLES variables x0, x1, ...
+// Each monomial's exponents are packed one byte per variable into a 64-bit
+// key, x0 in the most significant byte, so comparing keys is lexicographic
+// order and multiplying monomials is adding keys. Terms are stored as two
+// flat arrays (keys ascending, coefficients) with no zero coefficients.
+// Exponents go up to MAX_EXPONENT, so the sum of two never carries into the
+// next variable's byte.
+class MultivariatePolynomial
+{
+public:
+    static constexpr int MAX_VARIABLES = 8;
+    static constexpr int MAX_EXPONENT = 127;
+
+    // Recursive Horner scheme (in x0, then x1 inside each coefficient, ...)
+    // compiled once into straight-line steps over a few registers
+    class Plan
+    {
+    public:
+        struct Step
+        {
+            enum Op : uint8_t
+            {
+                CONST,  // reg[dst] = value
+                HORNER, // reg[dst] = reg[dst] * power[slot] + reg[dst + 1]
+                SCALE   // reg[dst] *= power[slot]
+            } op;
+            uint8_t dst;
+            uint32_t slot;
+            double value;
+        };
+
+    private:
+        int vars;
+        vector<Step> steps;
+        vector<pair<int, int>> powers; // (variable, exponent) per slot, sorted
+
+    public:
+        Plan();
+        explicit Plan(const MultivariatePolynomial &p);
+
+        int variables() const;
+        double evaluate(const double *x) const;                       // x holds variables() values
+        void evaluate(const double *points, double *out, size_t n) const; // Row i of points is point i
+    };
+
+private:
+    int vars;
+    vector<uint64_t> keys; // Packed exponents, strictly ascending
+    vector<double> coeffs; // Coefficient of each key
+
+    static uint64_t unit(int variable);
+    static MultivariatePolynomial fromUnsorted(int variables, vector<pair<uint64_t, double>> &terms);
+
+public:
+    // Constructors
+    MultivariatePolynomial();                        // Zero in one variable
+    explicit MultivariatePolynomial(int variables); // Zero; use constant() for a scalar
+    // Sum of coefficient * x^exponents; exponents has one entry per variable
+    MultivariatePolynomial(int variables, const vector<pair<vector<int>, double>> &terms);
+    static MultivariatePolynomial constant(int variables, double value);
+    static MultivariatePolynomial variable(int variables, int index); // x_index
+
+    // Arithmetic operators
+    MultivariatePolynomial operator+(const MultivariatePolynomial &other) const;
+    MultivariatePolynomial operator-(const MultivariatePolynomial &other) const;
+    MultivariatePolynomial operator*(const MultivariatePolynomial &other) const; // Throws overflow_error past MAX_EXPONENT
+
+    // Equality operator
+    bool operator==(const MultivariatePolynomial &other) const;
+
+    // Output operator
+    friend ostream &operator<<(ostream &out, const MultivariatePolynomial &p);
+
+    // Utility functions
+    int variables() const;
+    size_t terms() const;                  // Number of nonzero terms
+    int exponent(size_t term, int variable) const;
+    double coefficient(size_t term) const; // Terms in ascending lexicographic order
+    double coefficient(const vector<int> &exponents) const;
+    int degree() const;                    // Total degree, -1 for zero
+    int degree(int variable) const;        // Highest power of one variable, -1 for zero
+    double evaluate(const double *x) const; // Term by term; use plan() for repeated evaluation
+    Plan plan() const;
+    MultivariatePolynomial derivative(int variable) const; // Partial derivative
+    // Replace x_variable by q(x_into); into defaults to the same variable
+    MultivariatePolynomial substitute(int variable, const Polynomial &q, int into = -1) const;
+};
+
+#endif // POLYNOMIAL_MULTIVARIATE_H
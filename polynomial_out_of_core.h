@@ -0,0 +1,44 @@
+#ifndef POLYNOMIAL_OUT_OF_CORE_H
+#define POLYNOMIAL_OUT_OF_CORE_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include "polynomial.h"
+
+// A polynomial whose coefficients stay on disk: a raw file of little-endian
+// doubles, coefficient of x^0 first. Operations stream the file in blocks of
+// blockCoefficients doubles; a prefetch thread reads the next block while
+// the current one is being used, so memory stays at a few blocks no matter
+// how large the file is.
+class OutOfCorePolynomial
+{
+private:
+    int fd;
+    uint64_t count; // Number of coefficients in the file
+    string path;
+
+public:
+    static const size_t DEFAULT_BLOCK = 1 << 20;
+
+    explicit OutOfCorePolynomial(const string &path);
+    ~OutOfCorePolynomial();
+
+    OutOfCorePolynomial(const OutOfCorePolynomial &) = delete;
+    OutOfCorePolynomial &operator=(const OutOfCorePolynomial &) = delete;
+
+    // Write coefficients to a file in the layout read by this class
+    static void write(const string &path, span<const double> coefficients);
+
+    uint64_t size() const;  // Number of coefficients
+    int64_t degree() const; // size() - 1
+
+    // Horner evaluation at n points in one pass over the file, last block first
+    void evaluate(const double *xs, double *out, size_t n, size_t blockCoefficients = DEFAULT_BLOCK) const;
+
+    // Schoolbook product a * b written to outPath one output block at a time
+    static void multiply(const OutOfCorePolynomial &a, const OutOfCorePolynomial &b, const string &outPath,
+                         size_t blockCoefficients = DEFAULT_BLOCK);
+};
+
+#endif // POLYNOMIAL_OUT_OF_CORE_H
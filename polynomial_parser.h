@@ -0,0 +1,50 @@
+#ifndef POLYNOMIAL_PARSER_H
+#define POLYNOMIAL_PARSER_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include "polynomial.h"
+#include "polynomial_view.h"
+
+// Text parser, the inverse of operator<<. Accepts
+//   - the chat_gpt backend output:    "1x^2 + 2x + 3", " - 2x^2 + 4"
+//   - the perplexity backend output:  "3x^2+2x^1+1", "-2x^2+4", "0"
+//   - hand-written terms:             "3x^2 - 2x + 1", "-x^3 + x"
+//   - a coefficient list from x^0 up: "{1, 2, 3}" or "[1 2 3]"
+// An empty line is the zero polynomial (the chat_gpt backend prints zero as
+// nothing). Numbers are read with from_chars, and parsing into a reused
+// vector does not allocate once it has grown to the largest degree seen.
+class PolynomialParser
+{
+public:
+    // Highest exponent accepted, so malformed input cannot request huge
+    // allocations; larger exponents and longer lists are parse errors
+    static constexpr size_t MAX_DEGREE = 1 << 20;
+
+    struct FileStats
+    {
+        size_t lines = 0;           // Lines parsed
+        size_t failures = 0;        // Lines that did not parse
+        size_t firstFailure = 0;    // 1-based line number of the first failure, 0 if none
+    };
+
+    // Called once per parsed line with its 1-based line number; may be called
+    // from several threads at once and in any order
+    using LineCallback = function<void(size_t line, PolynomialView poly)>;
+
+    // Parse into coeffs (resized, capacity reused). Returns false on error
+    // and sets error, if given, to a short description with the column.
+    static bool parse(string_view text, vector<double> &coeffs, string *error = nullptr);
+
+    // Parse into a Polynomial, throwing invalid_argument on error
+    static Polynomial parse(string_view text);
+
+    // Parse a file with one polynomial per line. The file is read in chunks
+    // of chunkBytes, and each chunk is split at line boundaries across
+    // threads workers, so memory stays bounded for files of any size.
+    static FileStats parseFile(const string &path, const LineCallback &callback,
+                               unsigned threads = 0, size_t chunkBytes = 64 << 20);
+};
+
+#endif // POLYNOMIAL_PARSER_H
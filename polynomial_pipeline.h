@@ -0,0 +1,46 @@
+#ifndef POLYNOMIAL_PIPELINE_H
+#define POLYNOMIAL_PIPELINE_H
+
+#include <string>
+#include "polynomial.h"
+
+// A sequence of operations applied to one polynomial at a time, as used by
+// the polytool batch driver. Steps are given as text:
+//   derivative          p'
+//   integral            antiderivative with zero constant
+//   compose=TEXT        p(q) for q parsed by PolynomialParser
+//   evaluate@X1,X2,...  values at the listed points
+//   roots@G1,G2,...     one Newton root per starting guess ("roots" alone uses 1)
+// evaluate and roots turn the polynomial into numbers, so they must be last.
+class PolynomialPipeline
+{
+private:
+    enum Kind
+    {
+        DERIVATIVE,
+        INTEGRAL,
+        COMPOSE,
+        EVALUATE,
+        ROOTS
+    };
+
+    struct Step
+    {
+        Kind kind;
+        Polynomial inner;      // compose
+        vector<double> values; // evaluate points, root guesses
+    };
+
+    vector<Step> steps;
+
+public:
+    void add(const string &spec); // Throws invalid_argument on a bad step
+    size_t size() const;
+
+    // Run the steps on p and append one line to out: the resulting polynomial
+    // or comma-separated numbers. A step that throws writes "error: <what>"
+    // instead and apply returns false.
+    bool apply(const Polynomial &p, string &out) const;
+};
+
+#endif // POLYNOMIAL_PIPELINE_H
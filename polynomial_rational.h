@@ -0,0 +1,80 @@
+#ifndef POLYNOMIAL_RATIONAL_H
+#define POLYNOMIAL_RATIONAL_H
+
+#include <limits>
+#include "polynomial.h"
+
+// A quotient of two polynomials, kept in lowest terms: common factors are
+// cancelled with a Euclidean GCD after every operation and the denominator
+// is made monic. By default only factors that are common to within a few
+// ulps cancel. A larger tolerance opts in to approximate cancellation, which
+// can change the function by about that relative amount. The numerator and
+// denominator coefficients are also stored interleaved, so evaluation runs
+// both Horner recurrences in one pass.
+class RationalFunction
+{
+public:
+    // num / den written as
+    //   polynomial + sum a / (x - root)^power + sum (b x + c) / (x^2 + p x + q)^power
+    // where x^2 + p x + q has no real roots. Built once, it gives the
+    // antiderivative in closed form.
+    struct PartialFractions
+    {
+        struct Linear
+        {
+            double root;
+            int power;
+            double a;
+        };
+        struct Quadratic
+        {
+            double p, q;
+            int power;
+            double b, c;
+        };
+
+        Polynomial polynomial;
+        vector<Linear> linear;
+        vector<Quadratic> quadratic;
+
+        double evaluate(double x) const;
+        double antiderivative(double x) const;       // Valid between consecutive real poles
+        double integral(double x1, double x2) const; // Throws domain_error if a pole lies in [x1, x2]
+    };
+
+    // Relative size below which a remainder counts as zero in the GCD
+    static constexpr double EXACT_TOLERANCE = 32 * numeric_limits<double>::epsilon();
+
+private:
+    Polynomial num, den;
+    double tolerance; // Cancellation tolerance, at least EXACT_TOLERANCE
+    vector<double> fused; // num_0, den_0, num_1, den_1, ... padded to equal length
+    void reduce();
+
+public:
+    // Constructors
+    RationalFunction(); // Constant 0
+    RationalFunction(const Polynomial &numerator); // numerator / 1
+    // Throws invalid_argument if denominator is zero or tolerance is below EXACT_TOLERANCE
+    RationalFunction(const Polynomial &numerator, const Polynomial &denominator, double tolerance = EXACT_TOLERANCE);
+
+    // Arithmetic operators
+    RationalFunction operator+(const RationalFunction &other) const;
+    RationalFunction operator-(const RationalFunction &other) const;
+    RationalFunction operator*(const RationalFunction &other) const;
+    RationalFunction operator/(const RationalFunction &other) const; // Throws invalid_argument for a zero divisor
+
+    // Output operator
+    friend ostream &operator<<(ostream &out, const RationalFunction &r);
+
+    // Utility functions
+    const Polynomial &numerator() const;
+    const Polynomial &denominator() const; // Monic
+    double evaluate(double x) const;       // Numerator and denominator in a single pass
+    void evaluate(const double *xs, double *out, size_t n) const;
+    RationalFunction derivative() const;   // Quotient rule
+    PartialFractions partialFractions() const;
+    double integral(double x1, double x2) const; // Throws domain_error if a pole lies in [x1, x2]
+};
+
+#endif // POLYNOMIAL_RATIONAL_H
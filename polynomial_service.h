@@ -0,0 +1,127 @@
+#ifndef POLYNOMIAL_SERVICE_H
+#define POLYNOMIAL_SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "polynomial.h"
+
+// Local evaluation service. A server loads a set of polynomials once and
+// answers evaluation requests on a Unix domain socket; requests for the same
+// polynomial that arrive within a short window are joined into one batched
+// Plan evaluation.
+//
+// Protocol (native byte order, one request in flight per connection):
+//   request   u32 polynomial index, u32 point count, count doubles
+//   response  u32 status, u32 value count, count doubles
+// A request with more than MAX_POINTS points is answered with
+// TOO_MANY_POINTS and the connection is closed.
+
+namespace polyservice
+{
+    const uint32_t MAX_POINTS = 1 << 16;
+
+    enum Status : uint32_t
+    {
+        OK = 0,
+        UNKNOWN_POLYNOMIAL = 1,
+        TOO_MANY_POINTS = 2
+    };
+
+    struct RequestHeader
+    {
+        uint32_t index;
+        uint32_t count;
+    };
+
+    struct ResponseHeader
+    {
+        uint32_t status;
+        uint32_t count;
+    };
+}
+
+struct PolynomialServiceOptions
+{
+    unsigned windowMicros = 100; // How long the first request of a batch waits for others
+    size_t maxBatch = 4096;      // Points that close a batch before the window ends
+};
+
+class PolynomialServer
+{
+private:
+    // A request waiting in a batch; its connection thread owns the buffers
+    struct Pending
+    {
+        const double *xs;
+        double *out;
+        size_t count;
+        bool done;
+    };
+
+    // Batch being collected for one polynomial. The first request to arrive
+    // becomes the leader: it waits out the window, evaluates everything that
+    // joined and wakes the others.
+    struct Queue
+    {
+        mutex lock;
+        condition_variable changed;
+        vector<Pending *> batch;
+        size_t points = 0;
+        bool leaderWaiting = false;
+    };
+
+    vector<Polynomial::Plan> plans;
+    vector<unique_ptr<Queue>> queues;
+    PolynomialServiceOptions options;
+    string socketPath;
+    int listenFd;
+
+    atomic<bool> stopping{false};
+    mutex connectionsLock;
+    condition_variable connectionClosed;
+    vector<int> connections; // One detached handler thread each
+
+    atomic<size_t> requests{0};
+    atomic<size_t> batches{0};
+
+    void serve(int fd);
+    void evaluate(uint32_t index, const double *xs, double *out, size_t n);
+
+public:
+    // Binds and listens on socketPath; run() then accepts connections
+    PolynomialServer(const vector<Polynomial> &polynomials, const string &socketPath,
+                     PolynomialServiceOptions options = {});
+    ~PolynomialServer();
+
+    PolynomialServer(const PolynomialServer &) = delete;
+    PolynomialServer &operator=(const PolynomialServer &) = delete;
+
+    void run();  // Serve until stop() is called and every connection has closed
+    void stop(); // Safe to call from any thread
+
+    size_t requestCount() const; // Requests answered with OK
+    size_t batchCount() const;   // Batched evaluations performed
+};
+
+class PolynomialClient
+{
+private:
+    int fd;
+
+public:
+    explicit PolynomialClient(const string &socketPath);
+    ~PolynomialClient();
+
+    PolynomialClient(const PolynomialClient &) = delete;
+    PolynomialClient &operator=(const PolynomialClient &) = delete;
+
+    // out[i] = p_index(xs[i]); throws runtime_error if the server refuses
+    void evaluate(uint32_t index, const double *xs, size_t n, double *out);
+};
+
+#endif // POLYNOMIAL_SERVICE_H
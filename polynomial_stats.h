@@ -0,0 +1,93 @@
+#ifndef POLYNOMIAL_STATS_H
+#define POLYNOMIAL_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+// Optional instrumentation of the Polynomial methods.
+// Build with -DPOLYNOMIAL_STATS to count calls, inclusive nanoseconds,
+// coefficient-vector allocations and bytes per method. Counters live in a
+// per-thread block written only by its owner (relaxed loads and stores, no
+// read-modify-write), and snapshot() merges all blocks on read. Without the
+// define the macros expand to nothing and snapshots are all zero.
+
+namespace polystats
+{
+    enum Method
+    {
+        CONSTRUCT,
+        COPY,
+        ASSIGN,
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        EQUALS,
+        HASH,
+        OUTPUT,
+        DEGREE,
+        EVALUATE,
+        EVALUATE_DERIVATIVES,
+        EVALUATE_ACCURATE,
+        EVALUATE_INTERVAL,
+        PLAN,
+        COMPOSE,
+        DERIVATIVE,
+        INTEGRAL,
+        INTEGRAL_RANGE,
+        CACHED_DERIVATIVE,
+        CACHED_INTEGRAL,
+        GET_ROOT,
+        SET_COEFFICIENTS,
+        GET_COEFFICIENT,
+        METHOD_COUNT
+    };
+
+    struct Counters
+    {
+        uint64_t calls = 0;
+        uint64_t nanoseconds = 0;
+        uint64_t allocations = 0; // Coefficient vectors allocated
+        uint64_t bytes = 0;       // Bytes in those vectors
+    };
+
+    struct Snapshot
+    {
+        Counters methods[METHOD_COUNT];
+    };
+
+    const char *methodName(Method method);
+    Snapshot snapshot();                                    // Merge all threads
+    void reset();                                           // Zero all counters
+    bool dumpPrometheus(const string &path);                // Text exposition format
+    void writePrometheus(ostream &out, const Snapshot &stats);
+
+    // Hot path hooks used by the macros below
+    void record(Method method, uint64_t nanoseconds);
+    void recordAllocation(size_t bytes); // Charged to the innermost active method
+
+    class Scope
+    {
+    private:
+        Method method;
+        Method outer;
+        chrono::steady_clock::time_point start;
+
+    public:
+        explicit Scope(Method method);
+        ~Scope();
+    };
+}
+
+#ifdef POLYNOMIAL_STATS
+#define POLY_STATS_SCOPE(method) polystats::Scope polyStatsScope(polystats::method)
+#define POLY_STATS_ALLOC(count) polystats::recordAllocation((count) * sizeof(double))
+#else
+#define POLY_STATS_SCOPE(method)
+#define POLY_STATS_ALLOC(count)
+#endif
+
+#endif // POLYNOMIAL_STATS_H
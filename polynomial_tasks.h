@@ -0,0 +1,68 @@
+#ifndef POLYNOMIAL_TASKS_H
+#define POLYNOMIAL_TASKS_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+// Fork/join scheduler used by the divide-and-conquer algorithms (blocked
+// multiply, compose). Every worker owns a deque: it pushes and pops its own
+// tasks at the back and steals from the front of the others when it runs
+// dry. A thread waiting in sync() runs queued tasks instead of blocking, so
+// nested fork/join never deadlocks.
+//
+// Splitting is driven by the grain size, the smallest amount of work (in
+// multiply-adds) worth a task; jobs below it run serially on the caller. In
+// deterministic mode the split depends only on the operand sizes and the
+// grain, so results are bit-identical for any worker count. Otherwise large
+// jobs use a coarser grain so every worker gets a few tasks and no more,
+// which lets rounding vary with the worker count.
+
+namespace polytasks
+{
+    // Threads taking part in the work, including the caller. 1 runs every
+    // task on the calling thread. Throws logic_error while any TaskGroup is
+    // alive anywhere in the process, since its tasks may still be using the
+    // pool. That includes the groups multiply, compose, Bernstein root
+    // finding and the tools open internally on other threads, so set the
+    // count at startup or while no other thread is computing.
+    void setWorkerCount(unsigned count);
+    unsigned workerCount();
+
+    void setGrainSize(size_t multiplyAdds);
+    size_t grainSize();
+
+    void setDeterministic(bool on);
+    bool deterministic();
+
+    // Grain to use for a job of totalWork multiply-adds, never below
+    // grainSize(); callers run the job serially when it is no larger
+    size_t effectiveGrain(size_t totalWork);
+
+    class TaskGroup
+    {
+    private:
+        atomic<size_t> pending{0};
+        mutex errorLock;
+        exception_ptr error;
+
+        void wait();
+
+    public:
+        TaskGroup();
+        ~TaskGroup(); // Waits for spawned tasks, dropping any error
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        void spawn(function<void()> task);
+        void sync(); // Wait for every spawned task, rethrowing the first error
+
+        void finish(exception_ptr failure); // Used by the scheduler
+    };
+}
+
+#endif // POLYNOMIAL_TASKS_H
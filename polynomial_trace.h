@@ -0,0 +1,49 @@
+#ifndef POLYNOMIAL_TRACE_H
+#define POLYNOMIAL_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Optional timeline tracing of the heavy Polynomial operations.
+// Build with -DPOLYNOMIAL_TRACE to record a span for every multiply, compose
+// and root search, with the operand degrees as arguments. Each thread writes
+// into its own fixed-size ring buffer (oldest spans are overwritten), so
+// recording takes no lock. A ring is handed to a new thread once its owner
+// exits, so memory is bounded by the number of threads tracing at once.
+// flush() writes everything to Chrome trace_event JSON, which opens in
+// Perfetto or chrome://tracing.
+
+namespace polytrace
+{
+    // Spans kept per thread; takes effect for threads that start tracing
+    // later. Idle rings of an earlier capacity are not reused; they keep
+    // their spans for flush() until clear() frees them.
+    void setCapacity(size_t spansPerThread);
+    bool flush(const string &path); // Write all buffered spans as trace_event JSON
+    void clear();                   // Drop all buffered spans
+    size_t ringCount();             // Rings allocated, about one per thread tracing at once
+
+    class Span
+    {
+    private:
+        const char *name;
+        const char *argName[2];
+        int64_t argValue[2];
+        uint64_t start;
+
+    public:
+        Span(const char *name, const char *argName0 = nullptr, int64_t arg0 = 0,
+             const char *argName1 = nullptr, int64_t arg1 = 0);
+        ~Span();
+    };
+}
+
+#ifdef POLYNOMIAL_TRACE
+#define POLY_TRACE_SPAN(...) polytrace::Span polyTraceSpan(__VA_ARGS__)
+#else
+#define POLY_TRACE_SPAN(...)
+#endif
+
+#endif // POLYNOMIAL_TRACE_H
@@ -0,0 +1,51 @@
+#ifndef POLYNOMIAL_VIEW_H
+#define POLYNOMIAL_VIEW_H
+
+#include <span>
+#include "polynomial.h"
+
+// Read-only, non-owning view of coefficients stored elsewhere (a Polynomial,
+// a memory-mapped catalog, shared memory, a network frame). Coefficient i is
+// the coefficient of x^i, as in Polynomial. The viewed memory must outlive
+// the view. Polynomial converts to a view implicitly, so these kernels are
+// the single implementation of the const algorithms.
+class PolynomialView
+{
+private:
+    span<const double> coeffs;
+
+public:
+    // Constructors
+    PolynomialView();
+    PolynomialView(span<const double> coefficients);
+
+    // Arithmetic into caller-provided storage. Each returns the number of
+    // coefficients written and throws invalid_argument if out is too small.
+    // out must not overlap a or b: the kernels assume no aliasing.
+    static size_t add(PolynomialView a, PolynomialView b, span<double> out);      // max(|a|, |b|)
+    static size_t subtract(PolynomialView a, PolynomialView b, span<double> out); // max(|a|, |b|)
+    static size_t multiply(PolynomialView a, PolynomialView b, span<double> out); // |a| + |b| - 1
+    static size_t compose(PolynomialView p, PolynomialView q, span<double> out);  // (|p| - 1)(|q| - 1) + 1
+    static size_t derivative(PolynomialView p, span<double> out);                 // |p| - 1
+    static size_t integral(PolynomialView p, span<double> out);                   // |p| + 1
+
+    // Utility functions
+    int degree() const;                                                            // Highest stored power, -1 when empty
+    size_t size() const;                                                           // Number of stored coefficients
+    double evaluate(double x) const;                                               // Horner evaluation at x
+    void evaluate(const double *xs, double *out, size_t n) const;                  // Evaluate at n points
+    void evaluateWithDerivatives(double x, int k, double *out) const;              // out[j] = p^(j)(x) for j = 0..k
+    double evaluateAccurate(double x, double *errorBound = nullptr) const;         // Compensated Horner
+    void evaluateAccurate(const double *xs, double *out, size_t n, double *errorBounds = nullptr) const;
+    void evaluateInterval(double lo, double hi, double &outLo, double &outHi) const; // Enclosure of p([lo, hi])
+    void evaluateInterval(const double *los, const double *his, double *outLo, double *outHi, size_t n) const;
+    Polynomial derivative() const;                                                 // Derivative as an owning polynomial
+    Polynomial integral() const;                                                   // Antiderivative as an owning polynomial
+    double integral(double x1, double x2) const;                                   // Integrate from x1 to x2
+    double getRoot(double guess = 1, double tolerance = 1e-6, int maxIter = 100) const; // Newton iteration
+    double getCoefficient(int degree) const;                                       // 0 outside the stored range
+    Polynomial toPolynomial() const;                                               // Copy into an owning polynomial
+    span<const double> coefficients() const;
+};
+
+#endif // POLYNOMIAL_VIEW_H
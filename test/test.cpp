@@ -1,12 +1,41 @@
 #include <iostream>
 #include <vector>
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #include "../polynomial.h"
+#include "../polynomial_batch.h"
+#include "../polynomial_cache.h"
+#include "../polynomial_stats.h"
+#include "../polynomial_trace.h"
+#include "../polynomial_catalog.h"
+#include "../polynomial_view.h"
+#include "../polynomial_parser.h"
+#include "../polynomial_format.h"
+#include "../polynomial_out_of_core.h"
+#include "../polynomial_tasks.h"
+#include "../polynomial_async.h"
+#include "../polynomial_service.h"
+#include "../polynomial_pipeline.h"
+#include "../polynomial_dispatch.h"
+#include "../polynomial_bernstein.h"
+#include "../polynomial_rational.h"
+#include "../polynomial_multivariate.h"
+#include "../polynomial_fitter.h"
 
 using namespace std;
 using namespace std::chrono;
 
+// Times one run of a test including its output; see bench/bench.cpp for real measurements
 void measureTime(const string &testName, const std::function<void()> &testFunction)
 {
     auto start = high_resolution_clock::now();
@@ -16,6 +45,12 @@ void measureTime(const string &testName, const std::function<void()> &testFuncti
     cout << testName << " - Execution time: " << duration.count() << " microseconds." << endl;
 }
 
+// Socket path private to this process, so concurrent test runs do not collide
+string testSocketPath()
+{
+    return "/tmp/polynomial_test_" + to_string(getpid()) + ".sock";
+}
+
 void testPolynomial()
 {
     // GROUP 1: Basic Constructor and Arithmetic Operator Tests (20 tests)
@@ -1298,6 +1333,1313 @@ void testPolynomial()
     cout << "Input: p(x) = 3 + 2x + x^2, q(x) = 4 + 2x + x^2, Equality" << endl;
     if (!(p1 == p2)) cout << "Passed: Inequality of different polynomials." << endl;
     else cout << "Failed: Inequality of different polynomials." << endl; });
+
+    // GROUP 6: Evaluation Plan Tests
+    cout << "=== GROUP 6: Evaluation Plan Tests ===" << endl;
+
+    // Test 101: Plan of a quadratic matches evaluate
+    cout << endl;
+    measureTime("Test 101", []()
+                {
+    Polynomial p({3, 2, 1}); // p(x) = 3 + 2x + x^2
+    Polynomial::Plan plan = p.plan();
+    double result = plan.evaluate(2);
+    cout << "Input: p(x) = 3 + 2x + x^2, plan evaluate at x=2" << endl;
+    cout << "Actual Output: " << result << endl;
+    cout << "Expected Output: " << p.evaluate(2) << endl;
+    if (result == p.evaluate(2)) cout << "Passed: Plan evaluate of a quadratic." << endl;
+    else cout << "Failed: Plan evaluate of a quadratic." << endl; });
+
+    // Test 102: Plan of a degree 40 polynomial matches evaluate
+    cout << endl;
+    measureTime("Test 102", []()
+                {
+    vector<double> c(41);
+    for (size_t i = 0; i < c.size(); ++i) c[i] = (i % 3 == 0 ? -1.0 : 1.0) / (i + 1);
+    Polynomial p(c);
+    Polynomial::Plan plan = p.plan();
+    double maxError = 0;
+    for (int i = -20; i <= 20; ++i)
+    {
+        double x = i / 20.0;
+        double expected = p.evaluate(x);
+        maxError = max(maxError, abs(plan.evaluate(x) - expected) / max(1.0, abs(expected)));
+    }
+    cout << "Input: degree 40 polynomial, plan evaluate on [-1, 1]" << endl;
+    cout << "Actual Output: max relative error " << maxError << endl;
+    cout << "Expected Output: max relative error below 1e-12" << endl;
+    if (plan.degree() == 40 && maxError < 1e-12) cout << "Passed: Plan evaluate of a degree 40 polynomial." << endl;
+    else cout << "Failed: Plan evaluate of a degree 40 polynomial." << endl; });
+
+    // Test 103: Batched plan evaluate matches scalar plan evaluate
+    cout << endl;
+    measureTime("Test 103", []()
+                {
+    Polynomial p({1, -3, 0, 2, 5, -1, 0.5}); // p(x) = 0.5x^6 - x^5 + 5x^4 + 2x^3 - 3x + 1
+    Polynomial::Plan plan = p.plan();
+    vector<double> xs(19), out(19);
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = -2.0 + 0.25 * i;
+    plan.evaluate(xs.data(), out.data(), xs.size());
+    bool same = true;
+    for (size_t i = 0; i < xs.size(); ++i)
+        if (abs(out[i] - plan.evaluate(xs[i])) > 1e-12 * max(1.0, abs(out[i]))) same = false;
+    cout << "Input: p(x) = 0.5x^6 - x^5 + 5x^4 + 2x^3 - 3x + 1, batched plan evaluate at 19 points" << endl;
+    cout << "Actual Output: " << (same ? "identical" : "different") << endl;
+    cout << "Expected Output: identical" << endl;
+    if (same) cout << "Passed: Batched plan evaluate." << endl;
+    else cout << "Failed: Batched plan evaluate." << endl; });
+
+    // GROUP 7: Value and Derivatives Tests
+    cout << "=== GROUP 7: Value and Derivatives Tests ===" << endl;
+
+    // Test 104: Value and first three derivatives of a cubic
+    cout << endl;
+    measureTime("Test 104", []()
+                {
+    Polynomial p({1, -2, 3, 4}); // p(x) = 4x^3 + 3x^2 - 2x + 1
+    double values[4];
+    p.evaluateWithDerivatives(2, 3, values);
+    cout << "Input: p(x) = 4x^3 + 3x^2 - 2x + 1, value and 3 derivatives at x=2" << endl;
+    cout << "Actual Output: " << values[0] << ", " << values[1] << ", " << values[2] << ", " << values[3] << endl;
+    cout << "Expected Output: 41, 58, 54, 24" << endl;
+    if (values[0] == 41 && values[1] == 58 && values[2] == 54 && values[3] == 24) cout << "Passed: Value and derivatives of a cubic." << endl;
+    else cout << "Failed: Value and derivatives of a cubic." << endl; });
+
+    // Test 105: Derivatives beyond the degree are zero
+    cout << endl;
+    measureTime("Test 105", []()
+                {
+    Polynomial p({5, 3}); // p(x) = 3x + 5
+    double values[4];
+    p.evaluateWithDerivatives(-1, 3, values);
+    cout << "Input: p(x) = 3x + 5, value and 3 derivatives at x=-1" << endl;
+    cout << "Actual Output: " << values[0] << ", " << values[1] << ", " << values[2] << ", " << values[3] << endl;
+    cout << "Expected Output: 2, 3, 0, 0" << endl;
+    if (values[0] == 2 && values[1] == 3 && values[2] == 0 && values[3] == 0) cout << "Passed: Derivatives beyond the degree." << endl;
+    else cout << "Failed: Derivatives beyond the degree." << endl; });
+
+    // Test 106: Batched value and derivative
+    cout << endl;
+    measureTime("Test 106", []()
+                {
+    Polynomial p({-1, 0, 1}); // p(x) = x^2 - 1
+    double xs[3] = {0, 1, 3};
+    double out[6];
+    p.evaluateWithDerivatives(xs, 3, 1, out);
+    cout << "Input: p(x) = x^2 - 1, value and derivative at x=0, 1, 3" << endl;
+    cout << "Actual Output: " << out[0] << " " << out[1] << ", " << out[2] << " " << out[3] << ", " << out[4] << " " << out[5] << endl;
+    cout << "Expected Output: -1 0, 0 2, 8 6" << endl;
+    if (out[0] == -1 && out[1] == 0 && out[2] == 0 && out[3] == 2 && out[4] == 8 && out[5] == 6) cout << "Passed: Batched value and derivative." << endl;
+    else cout << "Failed: Batched value and derivative." << endl; });
+
+    // GROUP 8: Polynomial Batch Tests
+    cout << "=== GROUP 8: Polynomial Batch Tests ===" << endl;
+
+    // Test 107: Evaluate each polynomial of a batch at its own point
+    cout << endl;
+    measureTime("Test 107", []()
+                {
+    PolynomialBatch batch({Polynomial({1, 2, 3}), Polynomial({0, 1}), Polynomial({4})});
+    double xs[3] = {2, 5, 7};
+    double out[3];
+    batch.evaluate(xs, out);
+    cout << "Input: {3x^2 + 2x + 1 at 2, x at 5, 4 at 7}" << endl;
+    cout << "Actual Output: " << out[0] << ", " << out[1] << ", " << out[2] << endl;
+    cout << "Expected Output: 17, 5, 4" << endl;
+    if (out[0] == 17 && out[1] == 5 && out[2] == 4) cout << "Passed: Batch evaluate." << endl;
+    else cout << "Failed: Batch evaluate." << endl; });
+
+    // Test 108: Batch multiply, add and derivative agree with Polynomial
+    cout << endl;
+    measureTime("Test 108", []()
+                {
+    vector<Polynomial> a = {Polynomial({1, 1}), Polynomial({2, 0, 3}), Polynomial({-1, 4})};
+    vector<Polynomial> b = {Polynomial({1, -1}), Polynomial({0, 5, 1}), Polynomial({2, 2})};
+    PolynomialBatch product = PolynomialBatch(a) * PolynomialBatch(b);
+    PolynomialBatch sum = PolynomialBatch(a) + PolynomialBatch(b);
+    PolynomialBatch deriv = PolynomialBatch(a).derivative();
+    bool same = true;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        Polynomial expectedProduct = a[i] * b[i];
+        Polynomial expectedSum = a[i] + b[i];
+        Polynomial expectedDeriv = a[i].derivative();
+        for (int x = -2; x <= 2; ++x)
+        {
+            if (product.get(i).evaluate(x) != expectedProduct.evaluate(x)) same = false;
+            if (sum.get(i).evaluate(x) != expectedSum.evaluate(x)) same = false;
+            if (deriv.get(i).evaluate(x) != expectedDeriv.evaluate(x)) same = false;
+        }
+    }
+    cout << "Input: three pairs of polynomials, batch *, + and derivative" << endl;
+    cout << "Actual Output: " << (same ? "matches Polynomial" : "differs from Polynomial") << endl;
+    cout << "Expected Output: matches Polynomial" << endl;
+    if (same) cout << "Passed: Batch arithmetic." << endl;
+    else cout << "Failed: Batch arithmetic." << endl; });
+
+    // Test 109: Empty batches work and get checks its index
+    cout << endl;
+    measureTime("Test 109", []()
+                {
+    PolynomialBatch empty;
+    PolynomialBatch none(0, 3);
+    double out[1] = {7};
+    empty.evaluate(2.0, out);
+    PolynomialBatch product = none * none;
+    PolynomialBatch deriv = none.derivative();
+    bool thrown = false;
+    try
+    {
+        empty.get(0);
+    }
+    catch (const out_of_range &)
+    {
+        thrown = true;
+    }
+    cout << "Input: default and zero-count batches, evaluate, *, derivative, get(0)" << endl;
+    cout << "Actual Output: sizes " << product.size() << ", " << deriv.size() << ", get(0) " << (thrown ? "throws" : "does not throw") << endl;
+    cout << "Expected Output: sizes 0, 0, get(0) throws" << endl;
+    if (product.size() == 0 && deriv.size() == 0 && out[0] == 7 && thrown) cout << "Passed: Empty batch." << endl;
+    else cout << "Failed: Empty batch." << endl; });
+
+    // GROUP 9: Hashing and Cache Tests
+    cout << "=== GROUP 9: Hashing and Cache Tests ===" << endl;
+
+    // Test 110: Equal polynomials hash the same
+    cout << endl;
+    measureTime("Test 110", []()
+                {
+    Polynomial p1({1, 2, 3});
+    Polynomial p2({1, 2, 3, 0}); // Same polynomial with a trailing zero
+    hash<Polynomial> hasher;
+    cout << "Input: p(x) = 3x^2 + 2x + 1 with and without a trailing zero, hash" << endl;
+    cout << "Actual Output: " << (hasher(p1) == hasher(p2) ? "same hash" : "different hash") << endl;
+    cout << "Expected Output: same hash" << endl;
+    if (hasher(p1) == hasher(p2) && p1.equals(p2)) cout << "Passed: Hash of equal polynomials." << endl;
+    else cout << "Failed: Hash of equal polynomials." << endl; });
+
+    // Test 111: Tolerant equality
+    cout << endl;
+    measureTime("Test 111", []()
+                {
+    Polynomial p1({1, 2, 3});
+    Polynomial p2({1, 2 + 1e-9, 3});
+    cout << "Input: p(x) = 3x^2 + 2x + 1, q(x) = 3x^2 + (2 + 1e-9)x + 1, equals with tolerance 1e-6" << endl;
+    cout << "Actual Output: " << p1.equals(p2, 1e-6) << " " << p1.equals(p2) << endl;
+    cout << "Expected Output: 1 0" << endl;
+    if (p1.equals(p2, 1e-6) && !p1.equals(p2)) cout << "Passed: Tolerant equality." << endl;
+    else cout << "Failed: Tolerant equality." << endl; });
+
+    // Test 112: Cache hits on repeated operations and evicts beyond capacity
+    cout << endl;
+    measureTime("Test 112", []()
+                {
+    PolynomialCache cache(2, 1);
+    Polynomial p({1, 1});
+    Polynomial q({0, 2, 1});
+    Polynomial first = cache.multiply(p, q);
+    Polynomial second = cache.multiply(p, q);
+    cache.compose(p, q);
+    cache.derivative(q);
+    cout << "Input: multiply twice, then compose and derivative with capacity 2" << endl;
+    cout << "Actual Output: hits " << cache.hitCount() << ", misses " << cache.missCount() << ", size " << cache.size() << endl;
+    cout << "Expected Output: hits 1, misses 3, size 2" << endl;
+    if (first == p * q && second == first && cache.hitCount() == 1 && cache.missCount() == 3 && cache.size() == 2) cout << "Passed: Cache hits and eviction." << endl;
+    else cout << "Failed: Cache hits and eviction." << endl; });
+
+    // GROUP 10: Lazy Derivative and Integral Tests
+    cout << "=== GROUP 10: Lazy Derivative and Integral Tests ===" << endl;
+
+    // Test 113: Cached antiderivative is reused and refreshed after setCoefficients
+    cout << endl;
+    measureTime("Test 113", []()
+                {
+    Polynomial p({0, 2}); // p(x) = 2x
+    double first = p.integral(0, 3);
+    const Polynomial *cached = &p.cachedIntegral();
+    double second = p.integral(0, 3);
+    bool reused = cached == &p.cachedIntegral();
+    p.setCoefficients({1}); // p(x) = 1
+    double third = p.integral(0, 3);
+    cout << "Input: p(x) = 2x integrated on [0, 3] twice, then p(x) = 1 on [0, 3]" << endl;
+    cout << "Actual Output: " << first << ", " << second << ", " << third << endl;
+    cout << "Expected Output: 9, 9, 3" << endl;
+    if (first == 9 && second == 9 && third == 3 && reused) cout << "Passed: Cached antiderivative." << endl;
+    else cout << "Failed: Cached antiderivative." << endl; });
+
+    // Test 114: Cached derivative follows assignment
+    cout << endl;
+    measureTime("Test 114", []()
+                {
+    Polynomial p({1, 1, 1}); // p(x) = x^2 + x + 1
+    double before = p.cachedDerivative().evaluate(1);
+    p = Polynomial({0, 0, 0, 1}); // p(x) = x^3
+    double after = p.cachedDerivative().evaluate(2);
+    cout << "Input: p'(1) for x^2 + x + 1, then p'(2) after assigning x^3" << endl;
+    cout << "Actual Output: " << before << ", " << after << endl;
+    cout << "Expected Output: 3, 12" << endl;
+    if (before == 3 && after == 12) cout << "Passed: Cached derivative after assignment." << endl;
+    else cout << "Failed: Cached derivative after assignment." << endl; });
+
+    // GROUP 11: Instrumentation Tests
+    cout << "=== GROUP 11: Instrumentation Tests ===" << endl;
+
+    // Test 115: Calls and allocations are counted (only with -DPOLYNOMIAL_STATS)
+    cout << endl;
+    measureTime("Test 115", []()
+                {
+    polystats::reset();
+    Polynomial p({1, 2, 3});
+    Polynomial q = p * p;
+    p.evaluate(1);
+    p.evaluate(2);
+    polystats::Snapshot stats = polystats::snapshot();
+    uint64_t evaluations = stats.methods[polystats::EVALUATE].calls;
+    uint64_t bytes = stats.methods[polystats::MULTIPLY].bytes;
+#ifdef POLYNOMIAL_STATS
+    cout << "Input: p * p and two evaluate calls with instrumentation" << endl;
+    cout << "Actual Output: evaluate calls " << evaluations << ", multiply bytes " << bytes << endl;
+    cout << "Expected Output: evaluate calls 2, multiply bytes 40" << endl;
+    if (evaluations == 2 && bytes == 5 * sizeof(double)) cout << "Passed: Instrumentation counters." << endl;
+    else cout << "Failed: Instrumentation counters." << endl;
+#else
+    cout << "Input: p * p and two evaluate calls without instrumentation" << endl;
+    cout << "Actual Output: evaluate calls " << evaluations << ", multiply bytes " << bytes << endl;
+    cout << "Expected Output: evaluate calls 0, multiply bytes 0" << endl;
+    if (evaluations == 0 && bytes == 0) cout << "Passed: Instrumentation disabled." << endl;
+    else cout << "Failed: Instrumentation disabled." << endl;
+#endif
+    });
+
+    // Test 116: Trace export is valid trace_event JSON (spans only with -DPOLYNOMIAL_TRACE)
+    cout << endl;
+    measureTime("Test 116", []()
+                {
+    polytrace::clear();
+    Polynomial p({1, 2, 3});
+    Polynomial q = p.compose(Polynomial({0, 1}));
+    bool written = polytrace::flush("test_trace.json");
+    ifstream in("test_trace.json");
+    stringstream content;
+    content << in.rdbuf();
+    remove("test_trace.json");
+    bool hasEnvelope = content.str().find("\"traceEvents\"") != string::npos;
+    bool hasCompose = content.str().find("\"compose\"") != string::npos;
+#ifdef POLYNOMIAL_TRACE
+    bool expectedCompose = true;
+#else
+    bool expectedCompose = false;
+#endif
+    cout << "Input: p.compose(x) then flush the trace" << endl;
+    cout << "Actual Output: written " << written << ", compose span " << hasCompose << endl;
+    cout << "Expected Output: written 1, compose span " << expectedCompose << endl;
+    if (written && hasEnvelope && hasCompose == expectedCompose) cout << "Passed: Trace export." << endl;
+    else cout << "Failed: Trace export." << endl; });
+
+    // Test 117: Threads that exit hand their trace ring on, and its spans are still flushed
+    cout << endl;
+    measureTime("Test 117", []()
+                {
+    polytrace::clear();
+    size_t before = polytrace::ringCount();
+    for (int i = 0; i < 50; ++i)
+    {
+        thread([]() { polytrace::Span span("recycled"); }).join();
+    }
+    size_t after = polytrace::ringCount();
+    bool written = polytrace::flush("test_trace.json");
+    ifstream in("test_trace.json");
+    stringstream content;
+    content << in.rdbuf();
+    remove("test_trace.json");
+    polytrace::clear();
+    size_t spans = 0;
+    for (size_t at = content.str().find("\"recycled\""); at != string::npos; at = content.str().find("\"recycled\"", at + 1))
+        ++spans;
+    cout << "Input: 50 threads one after another, each tracing one span, then flush" << endl;
+    cout << "Actual Output: " << after - before << " new rings, " << spans << " spans flushed" << endl;
+    cout << "Expected Output: at most 1 new ring, 50 spans flushed" << endl;
+    if (written && after - before <= 1 && spans == 50) cout << "Passed: Trace ring recycling." << endl;
+    else cout << "Failed: Trace ring recycling." << endl; });
+
+    // Test 118: Idle rings of an earlier capacity are freed by clear()
+    cout << endl;
+    measureTime("Test 118", []()
+                {
+    polytrace::setCapacity(8);
+    thread([]() { polytrace::Span span("small"); }).join();
+    size_t withSmall = polytrace::ringCount();
+    polytrace::setCapacity(1 << 14);
+    polytrace::clear();
+    size_t afterClear = polytrace::ringCount();
+    cout << "Input: one thread traces with capacity 8, capacity restored, then clear" << endl;
+    cout << "Actual Output: " << withSmall - afterClear << " ring freed" << endl;
+    cout << "Expected Output: 1 ring freed" << endl;
+    if (withSmall - afterClear == 1) cout << "Passed: Stale trace rings freed." << endl;
+    else cout << "Failed: Stale trace rings freed." << endl; });
+
+    // GROUP 12: Binary Catalog Tests
+    cout << "=== GROUP 12: Binary Catalog Tests ===" << endl;
+
+    // Test 119: Write a catalog and read it back through zero-copy views
+    cout << endl;
+    measureTime("Test 119", []()
+                {
+    {
+        PolynomialCatalogWriter writer("test_catalog.bin");
+        writer.add(Polynomial({1, 2, 3}));
+        writer.add(Polynomial({-4, 0, 0, 1}));
+        writer.add(Polynomial({7}));
+    }
+    PolynomialCatalog catalog("test_catalog.bin");
+    bool aligned = true;
+    for (size_t i = 0; i < catalog.size(); ++i)
+        if (reinterpret_cast<uintptr_t>(catalog[i].coefficients().data()) % 64 != 0) aligned = false;
+    double a = catalog[0].evaluate(2), b = catalog[1].evaluate(2), c = catalog[2].evaluate(2);
+    double area = catalog[0].integral(0, 1);
+    remove("test_catalog.bin");
+    cout << "Input: catalog of 3x^2 + 2x + 1, x^3 - 4, 7; evaluate at x=2 and integrate the first on [0, 1]" << endl;
+    cout << "Actual Output: " << a << ", " << b << ", " << c << ", " << area << endl;
+    cout << "Expected Output: 17, 4, 7, 3" << endl;
+    if (catalog.size() == 3 && aligned && a == 17 && b == 4 && c == 7 && abs(area - 3) < 1e-12) cout << "Passed: Binary catalog round trip." << endl;
+    else cout << "Failed: Binary catalog round trip." << endl; });
+
+    // Test 120: Reject a file that is not a catalog
+    cout << endl;
+    measureTime("Test 120", []()
+                {
+    {
+        ofstream out("test_catalog.bin");
+        out << "3x^2 + 2x + 1 is not a binary catalog, it is just some text that is long enough";
+    }
+    bool rejected = false;
+    try
+    {
+        PolynomialCatalog catalog("test_catalog.bin");
+    }
+    catch (const runtime_error &)
+    {
+        rejected = true;
+    }
+    remove("test_catalog.bin");
+    cout << "Input: text file opened as a catalog" << endl;
+    cout << "Actual Output: " << (rejected ? "rejected" : "accepted") << endl;
+    cout << "Expected Output: rejected" << endl;
+    if (rejected) cout << "Passed: Invalid catalog rejected." << endl;
+    else cout << "Failed: Invalid catalog rejected." << endl; });
+
+    // GROUP 13: Polynomial View Tests
+    cout << "=== GROUP 13: Polynomial View Tests ===" << endl;
+
+    // Test 121: View over an external buffer
+    cout << endl;
+    measureTime("Test 121", []()
+                {
+    double buffer[3] = {-2, 0, 1}; // p(x) = x^2 - 2
+    PolynomialView view(buffer);
+    double root = view.getRoot(1);
+    cout << "Input: view of x^2 - 2, degree, evaluate at 3, integral on [0, 3], root from 1" << endl;
+    cout << "Actual Output: " << view.degree() << ", " << view.evaluate(3) << ", " << view.integral(0, 3) << ", " << root << endl;
+    cout << "Expected Output: 2, 7, 3, 1.41421" << endl;
+    if (view.degree() == 2 && view.evaluate(3) == 7 && abs(view.integral(0, 3) - 3) < 1e-12 && abs(root - sqrt(2.0)) < 1e-6) cout << "Passed: View over an external buffer." << endl;
+    else cout << "Failed: View over an external buffer." << endl; });
+
+    // Test 122: Arithmetic into caller-provided spans
+    cout << endl;
+    measureTime("Test 122", []()
+                {
+    Polynomial p({1, 1}); // p(x) = x + 1
+    Polynomial q({-1, 1}); // q(x) = x - 1
+    double product[3], sum[2], deriv[2];
+    size_t n = PolynomialView::multiply(p, q, product);
+    size_t m = PolynomialView::add(p, q, sum);
+    size_t d = PolynomialView::derivative(PolynomialView(span<const double>(product, n)), deriv);
+    cout << "Input: (x + 1)(x - 1), (x + 1) + (x - 1) and the derivative of the product" << endl;
+    cout << "Actual Output: " << product[0] << " " << product[1] << " " << product[2] << ", " << sum[0] << " " << sum[1] << ", " << deriv[0] << " " << deriv[1] << endl;
+    cout << "Expected Output: -1 0 1, 0 2, 0 2" << endl;
+    if (n == 3 && m == 2 && d == 2 && product[0] == -1 && product[1] == 0 && product[2] == 1 && sum[0] == 0 && sum[1] == 2 && deriv[0] == 0 && deriv[1] == 2) cout << "Passed: View arithmetic into spans." << endl;
+    else cout << "Failed: View arithmetic into spans." << endl; });
+
+    // Test 123: Output span that is too small is rejected
+    cout << endl;
+    measureTime("Test 123", []()
+                {
+    Polynomial p({1, 2, 3});
+    double out[2];
+    bool rejected = false;
+    try
+    {
+        PolynomialView::multiply(p, p, out);
+    }
+    catch (const invalid_argument &)
+    {
+        rejected = true;
+    }
+    cout << "Input: (3x^2 + 2x + 1)^2 into a span of 2 coefficients" << endl;
+    cout << "Actual Output: " << (rejected ? "rejected" : "accepted") << endl;
+    cout << "Expected Output: rejected" << endl;
+    if (rejected) cout << "Passed: Small output span rejected." << endl;
+    else cout << "Failed: Small output span rejected." << endl; });
+
+    // GROUP 14: Parser Tests
+    cout << "=== GROUP 14: Parser Tests ===" << endl;
+
+    // Test 124: Parse the output of operator<< back
+    cout << endl;
+    measureTime("Test 124", []()
+                {
+    Polynomial p({4, 0, -2.5, 1}); // p(x) = x^3 - 2.5x^2 + 4
+    stringstream text;
+    text << p;
+    Polynomial parsed = PolynomialParser::parse(text.str());
+    cout << "Input: parse \"" << text.str() << "\"" << endl;
+    cout << "Actual Output: " << parsed << endl;
+    cout << "Expected Output: " << p << endl;
+    if (parsed.equals(p)) cout << "Passed: Parse operator<< output." << endl;
+    else cout << "Failed: Parse operator<< output." << endl; });
+
+    // Test 125: Parse both backend formats, hand-written terms and coefficient lists
+    cout << endl;
+    measureTime("Test 125", []()
+                {
+    Polynomial expected({1, -2, 3}); // p(x) = 3x^2 - 2x + 1
+    const char *inputs[] = {"3x^2 - 2x + 1", "3x^2 + -2x + 1", "3x^2-2x^1+1", "1 - 2x + 3x^2", "{1, -2, 3}", "[1 -2 3]", " + 3x^2 - 2x + 1"};
+    bool all = true;
+    for (const char *input : inputs)
+        if (!PolynomialParser::parse(input).equals(expected)) all = false;
+    Polynomial implicitOne = PolynomialParser::parse("-x^2 + x");
+    cout << "Input: seven spellings of 3x^2 - 2x + 1, and -x^2 + x" << endl;
+    cout << "Actual Output: " << (all ? "all equal" : "mismatch") << ", " << implicitOne << endl;
+    cout << "Expected Output: all equal, " << Polynomial({0, 1, -1}) << endl;
+    if (all && implicitOne.equals(Polynomial({0, 1, -1}))) cout << "Passed: Parse all formats." << endl;
+    else cout << "Failed: Parse all formats." << endl; });
+
+    // Test 126: Malformed input is rejected
+    cout << endl;
+    measureTime("Test 126", []()
+                {
+    vector<double> coeffs;
+    bool a = PolynomialParser::parse("3x^ + 1", coeffs);
+    bool b = PolynomialParser::parse("3x 2", coeffs);
+    bool c = PolynomialParser::parse("{1, 2", coeffs);
+    cout << "Input: \"3x^ + 1\", \"3x 2\", \"{1, 2\"" << endl;
+    cout << "Actual Output: " << a << " " << b << " " << c << endl;
+    cout << "Expected Output: 0 0 0" << endl;
+    if (!a && !b && !c) cout << "Passed: Malformed input rejected." << endl;
+    else cout << "Failed: Malformed input rejected." << endl; });
+
+    // Test 127: Exponents above MAX_DEGREE are parse errors, not allocations
+    cout << endl;
+    measureTime("Test 127", []()
+                {
+    vector<double> coeffs;
+    string wrapError, hugeError;
+    bool wrap = PolynomialParser::parse("x^18446744073709551615", coeffs, &wrapError);
+    bool huge = PolynomialParser::parse("1 + x^99999999999", coeffs, &hugeError);
+    bool limit = PolynomialParser::parse("x^" + to_string(PolynomialParser::MAX_DEGREE), coeffs);
+    size_t limitSize = coeffs.size();
+    cout << "Input: \"x^18446744073709551615\", \"1 + x^99999999999\", \"x^MAX_DEGREE\"" << endl;
+    cout << "Actual Output: " << wrap << " (" << wrapError << ") " << huge << " (" << hugeError << ") " << limit << endl;
+    cout << "Expected Output: 0 (... At column 3.) 0 (... At column 7.) 1" << endl;
+    if (!wrap && !huge && limit && limitSize == PolynomialParser::MAX_DEGREE + 1 &&
+        wrapError.find("column 3") != string::npos && hugeError.find("column 7") != string::npos)
+        cout << "Passed: Exponent bound." << endl;
+    else cout << "Failed: Exponent bound." << endl; });
+
+    // Test 128: Parse a file in parallel chunks
+    cout << endl;
+    measureTime("Test 128", []()
+                {
+    {
+        ofstream out("test_parse.txt");
+        for (int i = 0; i < 20000; ++i)
+            out << i << "x^2 + " << i % 7 << "x - 1\n";
+        out << "not a polynomial\n";
+    }
+    atomic<long long> sum(0);
+    atomic<long long> lineSum(0);
+    PolynomialParser::FileStats stats = PolynomialParser::parseFile("test_parse.txt", [&](size_t line, PolynomialView poly)
+    {
+        sum += static_cast<long long>(poly.getCoefficient(2));
+        lineSum += line;
+    }, 4, 1 << 16);
+    remove("test_parse.txt");
+    long long expectedSum = 19999LL * 20000 / 2;
+    long long expectedLines = 20000LL * 20001 / 2;
+    cout << "Input: 20000 valid lines and one invalid line, 4 threads, 64 KiB chunks" << endl;
+    cout << "Actual Output: lines " << stats.lines << ", failures " << stats.failures << " at " << stats.firstFailure << endl;
+    cout << "Expected Output: lines 20001, failures 1 at 20001" << endl;
+    if (stats.lines == 20001 && stats.failures == 1 && stats.firstFailure == 20001 && sum == expectedSum && lineSum == expectedLines) cout << "Passed: Parallel file parsing." << endl;
+    else cout << "Failed: Parallel file parsing." << endl; });
+
+    // GROUP 15: Formatter Tests
+    cout << "=== GROUP 15: Formatter Tests ===" << endl;
+
+    // Test 129: Shortest round-trip output in both styles
+    cout << endl;
+    measureTime("Test 129", []()
+                {
+    Polynomial p({1, -2, 1.0 / 3}); // p(x) = x^2/3 - 2x + 1
+    string spaced, compact;
+    PolynomialFormat fmt;
+    PolynomialFormatter::appendTo(spaced, p, fmt);
+    fmt.style = PolynomialFormat::COMPACT;
+    PolynomialFormatter::appendTo(compact, p, fmt);
+    cout << "Input: p(x) = x^2/3 - 2x + 1 in spaced and compact style" << endl;
+    cout << "Actual Output: " << spaced << " | " << compact << endl;
+    cout << "Expected Output: 0.3333333333333333x^2 - 2x + 1 | 0.3333333333333333x^2-2x^1+1" << endl;
+    if (spaced == "0.3333333333333333x^2 - 2x + 1" && compact == "0.3333333333333333x^2-2x^1+1" && PolynomialParser::parse(spaced).equals(p)) cout << "Passed: Shortest round-trip formatting." << endl;
+    else cout << "Failed: Shortest round-trip formatting." << endl; });
+
+    // Test 130: Precision, ascending order and truncation into a small buffer
+    cout << endl;
+    measureTime("Test 130", []()
+                {
+    Polynomial p({-1, 0, 1.0 / 3}); // p(x) = x^2/3 - 1
+    PolynomialFormat fmt;
+    fmt.precision = 3;
+    fmt.ascending = true;
+    char buf[8];
+    size_t needed = PolynomialFormatter::format(p, buf, sizeof(buf), fmt);
+    char full[64];
+    PolynomialFormatter::format(p, full, sizeof(full), fmt);
+    cout << "Input: p(x) = x^2/3 - 1 with 3 digits, ascending, into 8 and 64 byte buffers" << endl;
+    cout << "Actual Output: " << buf << " | " << full << " (" << needed << " chars)" << endl;
+    cout << "Expected Output: -1 + 0. | -1 + 0.333x^2 (13 chars)" << endl;
+    if (string(buf) == "-1 + 0." && string(full) == "-1 + 0.333x^2" && needed == 13) cout << "Passed: Formatting options." << endl;
+    else cout << "Failed: Formatting options." << endl; });
+
+    // GROUP 16: Out-of-Core Tests
+    cout << "=== GROUP 16: Out-of-Core Tests ===" << endl;
+
+    // Test 131: Streamed Horner evaluation matches the in-memory polynomial
+    cout << endl;
+    measureTime("Test 131", []()
+                {
+    vector<double> coeffs(10000);
+    for (size_t i = 0; i < coeffs.size(); ++i) coeffs[i] = ((i * 37) % 11) - 5.0;
+    OutOfCorePolynomial::write("test_ooc.bin", coeffs);
+    OutOfCorePolynomial disk("test_ooc.bin");
+    Polynomial p(coeffs);
+    double xs[5] = {-1, -0.5, 0, 0.5, 0.999};
+    double out[5];
+    disk.evaluate(xs, out, 5, 999);
+    bool same = disk.degree() == 9999;
+    for (int i = 0; i < 5; ++i)
+        if (out[i] != p.evaluate(xs[i])) same = false;
+    remove("test_ooc.bin");
+    cout << "Input: degree 9999 polynomial on disk, evaluated at 5 points in blocks of 999" << endl;
+    cout << "Actual Output: " << out[0] << " " << out[1] << " " << out[2] << " " << out[3] << " " << out[4] << endl;
+    cout << "Expected Output: " << p.evaluate(xs[0]) << " " << p.evaluate(xs[1]) << " " << p.evaluate(xs[2]) << " " << p.evaluate(xs[3]) << " " << p.evaluate(xs[4]) << endl;
+    if (same) cout << "Passed: Out-of-core evaluation." << endl;
+    else cout << "Failed: Out-of-core evaluation." << endl; });
+
+    // Test 132: Blocked product on disk matches the in-memory product
+    cout << endl;
+    measureTime("Test 132", []()
+                {
+    vector<double> a(1000), b(700);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<double>((i * 13) % 7) - 3;
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<double>((i * 5) % 9) - 4;
+    OutOfCorePolynomial::write("test_ooc_a.bin", a);
+    OutOfCorePolynomial::write("test_ooc_b.bin", b);
+    {
+        OutOfCorePolynomial da("test_ooc_a.bin"), db("test_ooc_b.bin");
+        OutOfCorePolynomial::multiply(da, db, "test_ooc_c.bin", 128);
+    }
+    vector<double> product((a.size() + b.size() - 1));
+    ifstream in("test_ooc_c.bin", ios::binary);
+    in.read(reinterpret_cast<char *>(product.data()), product.size() * sizeof(double));
+    bool complete = in.gcount() == static_cast<streamsize>(product.size() * sizeof(double)) && in.peek() == EOF;
+    in.close();
+    remove("test_ooc_a.bin");
+    remove("test_ooc_b.bin");
+    remove("test_ooc_c.bin");
+    Polynomial expected = Polynomial(a) * Polynomial(b);
+    bool same = complete;
+    for (size_t i = 0; i < product.size(); ++i)
+        if (product[i] != expected.getCoefficient(i)) same = false;
+    cout << "Input: degree 999 times degree 699 on disk, blocks of 128 coefficients" << endl;
+    cout << "Actual Output: " << product.size() << " coefficients, first " << product[0] << ", last " << product.back() << endl;
+    cout << "Expected Output: 1699 coefficients, first " << expected.getCoefficient(0) << ", last " << expected.getCoefficient(1698) << endl;
+    if (same) cout << "Passed: Out-of-core multiplication." << endl;
+    else cout << "Failed: Out-of-core multiplication." << endl; });
+
+    // GROUP 17: Task Pool Tests
+    cout << "=== GROUP 17: Task Pool Tests ===" << endl;
+
+    // Test 133: Nested spawn/sync sums a range and propagates exceptions
+    cout << endl;
+    measureTime("Test 133", []()
+                {
+    polytasks::setWorkerCount(4);
+    function<long(long, long)> sum = [&](long lo, long hi) -> long
+    {
+        if (hi - lo <= 1000)
+        {
+            long s = 0;
+            for (long i = lo; i < hi; ++i) s += i;
+            return s;
+        }
+        long mid = (lo + hi) / 2, left = 0;
+        polytasks::TaskGroup group;
+        group.spawn([&]() { left = sum(lo, mid); });
+        long right = sum(mid, hi);
+        group.sync();
+        return left + right;
+    };
+    long total = sum(0, 1000000);
+    bool thrown = false;
+    try
+    {
+        polytasks::TaskGroup group;
+        group.spawn([]() { throw runtime_error("task failed"); });
+        group.sync();
+    }
+    catch (const runtime_error &)
+    {
+        thrown = true;
+    }
+    cout << "Input: sum of 0..999999 split into tasks of 1000, then a throwing task" << endl;
+    cout << "Actual Output: " << total << ", rethrown " << thrown << endl;
+    cout << "Expected Output: 499999500000, rethrown 1" << endl;
+    if (total == 499999500000L && thrown) cout << "Passed: Fork/join task group." << endl;
+    else cout << "Failed: Fork/join task group." << endl; });
+
+    // Test 134: Parallel multiply and compose give identical bits for any worker count
+    cout << endl;
+    measureTime("Test 134", []()
+                {
+    vector<double> a(600), b(500), q(4);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = sin(i * 0.7);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = cos(i * 1.3);
+    for (size_t i = 0; i < q.size(); ++i) q[i] = 0.25 * (i + 1);
+    Polynomial pa(a), pb(b), pq(q);
+    polytasks::setDeterministic(true);
+    polytasks::setGrainSize(4096);
+    vector<Polynomial> products, composed;
+    for (unsigned workers : {1u, 2u, 7u})
+    {
+        polytasks::setWorkerCount(workers);
+        products.push_back(pa * pb);
+        composed.push_back(pa.compose(pq));
+    }
+    polytasks::setDeterministic(false);
+    polytasks::setGrainSize(1 << 15);
+    polytasks::setWorkerCount(thread::hardware_concurrency());
+    bool identical = products[0] == products[1] && products[0] == products[2] &&
+                     composed[0] == composed[1] && composed[0] == composed[2];
+    double x = 0.3, expected = pa.evaluate(pq.evaluate(x));
+    double error = fabs(composed[0].evaluate(x) - expected) / fabs(expected);
+    cout << "Input: degree 599 * degree 499 and compose with a cubic on 1, 2 and 7 workers" << endl;
+    cout << "Actual Output: identical " << identical << ", degree " << composed[0].degree() << ", relative error " << error << endl;
+    cout << "Expected Output: identical 1, degree 1797, relative error < 1e-9" << endl;
+    if (identical && composed[0].degree() == 1797 && error < 1e-9) cout << "Passed: Deterministic parallel multiply and compose." << endl;
+    else cout << "Failed: Deterministic parallel multiply and compose." << endl; });
+
+    // Test 135: Composing an emptied polynomial gives zero
+    cout << endl;
+    measureTime("Test 135", []()
+                {
+    Polynomial p({1, 2});
+    p.setCoefficients({});
+    bool zero = true;
+    try
+    {
+        for (const Polynomial &q : {Polynomial({1, 1, 1}), Polynomial({1, 1})})
+        {
+            Polynomial r = p.compose(q);
+            if (r.degree() > 0 || r.evaluate(2.0) != 0) zero = false;
+        }
+    }
+    catch (const exception &)
+    {
+        zero = false;
+    }
+    cout << "Input: p.setCoefficients({}), compose with x^2 + x + 1 and x + 1" << endl;
+    cout << "Actual Output: " << (zero ? "zero" : "not zero") << endl;
+    cout << "Expected Output: zero" << endl;
+    if (zero) cout << "Passed: Compose of empty polynomial." << endl;
+    else cout << "Failed: Compose of empty polynomial." << endl; });
+
+    // GROUP 18: Async Tests
+    cout << "=== GROUP 18: Async Tests ===" << endl;
+
+    // Test 136: Futures of multiply, compose, roots and batched evaluation
+    cout << endl;
+    measureTime("Test 136", []()
+                {
+    Polynomial p({-2, 0, 1}); // p(x) = x^2 - 2
+    Polynomial q({1, 1});     // q(x) = x + 1
+    future<Polynomial> product = polyasync::multiplyAsync(p, q);
+    future<Polynomial> composed = polyasync::composeAsync(p, q);
+    future<vector<double>> roots = polyasync::rootsAsync(p, {1, -1});
+    future<vector<double>> values = polyasync::evaluateAsync(p, {0, 1, 2, 3});
+    Polynomial prod = product.get(), comp = composed.get();
+    vector<double> r = roots.get(), v = values.get();
+    cout << "Input: p(x) = x^2 - 2, q(x) = x + 1; p * q, p(q), roots from 1 and -1, p at 0..3" << endl;
+    cout << "Actual Output: " << prod << " | " << comp << " | " << r[0] << " " << r[1] << " | " << v[0] << " " << v[1] << " " << v[2] << " " << v[3] << endl;
+    cout << "Expected Output: 1x^3 + 1x^2 - 2x - 2 | 1x^2 + 2x - 1 | 1.41421 -1.41421 | -2 -1 2 7" << endl;
+    if (prod == p * q && comp.equals(Polynomial({-1, 2, 1})) && fabs(r[0] - sqrt(2.0)) < 1e-6 && fabs(r[1] + sqrt(2.0)) < 1e-6 && v == vector<double>({-2, -1, 2, 7})) cout << "Passed: Async operations." << endl;
+    else cout << "Failed: Async operations." << endl; });
+
+    // Test 137: Queue-depth limit and cancellation
+    cout << endl;
+    measureTime("Test 137", []()
+                {
+    polyasync::configure(1, 1);
+    vector<double> slowCoeffs(200, 1e-3);
+    vector<double> points(4000000, 0.5);
+    polyasync::CancellationToken slowToken, queuedToken;
+    future<vector<double>> slow = polyasync::evaluateAsync(Polynomial(slowCoeffs), points, slowToken);
+    while (polyasync::queued() > 0) this_thread::yield(); // Wait until it is running
+    future<Polynomial> waiting = polyasync::multiplyAsync(Polynomial({1, 1}), Polynomial({1, 1}), queuedToken);
+    bool full = false;
+    try
+    {
+        polyasync::multiplyAsync(Polynomial({1}), Polynomial({1}));
+    }
+    catch (const polyasync::QueueFull &)
+    {
+        full = true;
+    }
+    queuedToken.cancel();
+    slowToken.cancel();
+    bool slowCancelled = false, waitingCancelled = false;
+    try { slow.get(); } catch (const polyasync::Cancelled &) { slowCancelled = true; }
+    try { waiting.get(); } catch (const polyasync::Cancelled &) { waitingCancelled = true; }
+    polyasync::configure(thread::hardware_concurrency(), 1024);
+    cout << "Input: one thread, queue depth 1; a long evaluation, one queued call, one more call, then cancel both" << endl;
+    cout << "Actual Output: full " << full << ", running cancelled " << slowCancelled << ", queued cancelled " << waitingCancelled << endl;
+    cout << "Expected Output: full 1, running cancelled 1, queued cancelled 1" << endl;
+    if (full && slowCancelled && waitingCancelled) cout << "Passed: Async queue limit and cancellation." << endl;
+    else cout << "Failed: Async queue limit and cancellation." << endl; });
+
+    // GROUP 19: Evaluation Service Tests
+    cout << "=== GROUP 19: Evaluation Service Tests ===" << endl;
+
+    // Test 138: Concurrent clients get correct values from coalesced batches
+    cout << endl;
+    measureTime("Test 138", []()
+                {
+    vector<Polynomial> polys = {Polynomial({1, 2, 3}), Polynomial({-1, 0, 0, 1})}; // 3x^2 + 2x + 1, x^3 - 1
+    PolynomialServiceOptions options;
+    options.windowMicros = 200000; // Wide enough that every client joins the first batch per polynomial
+    string path = testSocketPath();
+    PolynomialServer server(polys, path, options);
+    thread serving(&PolynomialServer::run, &server);
+    atomic<int> correct{0}, connected{0};
+    vector<thread> clients;
+    for (int c = 0; c < 8; ++c)
+    {
+        clients.emplace_back([&, c]()
+                             {
+            PolynomialClient client(path);
+            ++connected;
+            while (connected < 8) this_thread::yield(); // Send together
+            double xs[3] = {c * 1.0, 0.5, -2.0}, out[3];
+            client.evaluate(c % 2, xs, 3, out);
+            if (out[0] == polys[c % 2].evaluate(xs[0]) && out[1] == polys[c % 2].evaluate(0.5) && out[2] == polys[c % 2].evaluate(-2.0))
+                ++correct; });
+    }
+    for (thread &t : clients) t.join();
+    server.stop();
+    serving.join();
+    cout << "Input: 8 clients released together, 3 points each, over 2 polynomials with a 200 ms window" << endl;
+    cout << "Actual Output: " << correct << " correct, " << server.requestCount() << " requests in " << server.batchCount() << " batches" << endl;
+    cout << "Expected Output: 8 correct, 8 requests in fewer than 8 batches" << endl;
+    if (correct == 8 && server.requestCount() == 8 && server.batchCount() < server.requestCount()) cout << "Passed: Coalesced service evaluation." << endl;
+    else cout << "Failed: Coalesced service evaluation." << endl; });
+
+    // Test 139: Unknown polynomial and oversized requests are refused
+    cout << endl;
+    measureTime("Test 139", []()
+                {
+    string path = testSocketPath();
+    PolynomialServer server({Polynomial({1, 1})}, path);
+    thread serving(&PolynomialServer::run, &server);
+    bool unknown = false, oversized = false;
+    double x = 1, y = 0;
+    {
+        PolynomialClient client(path);
+        try { client.evaluate(3, &x, 1, &y); } catch (const runtime_error &) { unknown = true; }
+        client.evaluate(0, &x, 1, &y); // The connection is still usable
+        vector<double> many(polyservice::MAX_POINTS + 1), out(many.size());
+        try { client.evaluate(0, many.data(), many.size(), out.data()); } catch (const invalid_argument &) { oversized = true; }
+    }
+    // The client refuses that locally, so send an oversized header by hand
+    polyservice::ResponseHeader response{polyservice::OK, 1};
+    bool closed = false;
+    {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0)
+        {
+            polyservice::RequestHeader request{0, polyservice::MAX_POINTS + 1};
+            char extra;
+            if (send(fd, &request, sizeof(request), MSG_NOSIGNAL) == sizeof(request) &&
+                recv(fd, &response, sizeof(response), MSG_WAITALL) == sizeof(response))
+                closed = recv(fd, &extra, 1, 0) == 0;
+        }
+        close(fd);
+    }
+    server.stop();
+    serving.join();
+    cout << "Input: x + 1 served; ask for polynomial 3, then p(1), then MAX_POINTS + 1 points from the client and raw" << endl;
+    cout << "Actual Output: unknown " << unknown << ", p(1) = " << y << ", oversized " << oversized
+         << ", raw status " << response.status << " count " << response.count << " closed " << closed << endl;
+    cout << "Expected Output: unknown 1, p(1) = 2, oversized 1, raw status 2 count 0 closed 1" << endl;
+    if (unknown && y == 2 && oversized && response.status == polyservice::TOO_MANY_POINTS && response.count == 0 && closed)
+        cout << "Passed: Service error handling." << endl;
+    else cout << "Failed: Service error handling." << endl; });
+
+    // GROUP 20: Pipeline Tests
+    cout << "=== GROUP 20: Pipeline Tests ===" << endl;
+
+    // Test 140: Polynomial steps followed by evaluation
+    cout << endl;
+    measureTime("Test 140", []()
+                {
+    PolynomialPipeline pipeline;
+    pipeline.add("compose=x + 1");
+    pipeline.add("derivative");
+    pipeline.add("evaluate@0,1,-0.5");
+    string out;
+    bool ok = pipeline.apply(Polynomial({0, 0, 1}), out); // x^2 -> (x + 1)^2 -> 2x + 2
+    PolynomialPipeline integrate;
+    integrate.add("integral");
+    string line;
+    integrate.apply(Polynomial({2}), line);
+    cout << "Input: x^2 through compose=x + 1, derivative, evaluate@0,1,-0.5; 2 through integral" << endl;
+    cout << "Actual Output: " << out.substr(0, out.size() - 1) << " / " << line.substr(0, line.size() - 1) << endl;
+    cout << "Expected Output: 2,4,1 / 2x" << endl;
+    if (ok && out == "2,4,1\n" && PolynomialParser::parse(line.substr(0, line.size() - 1)).equals(Polynomial({0, 2}))) cout << "Passed: Pipeline steps." << endl;
+    else cout << "Failed: Pipeline steps." << endl; });
+
+    // Test 141: Bad steps are rejected when added
+    cout << endl;
+    measureTime("Test 141", []()
+                {
+    int rejected = 0;
+    for (string spec : {"differentiate", "evaluate@", "evaluate@1,x", "compose=x^"})
+    {
+        PolynomialPipeline pipeline;
+        try { pipeline.add(spec); } catch (const invalid_argument &) { ++rejected; }
+    }
+    PolynomialPipeline terminal;
+    terminal.add("roots");
+    try { terminal.add("derivative"); } catch (const invalid_argument &) { ++rejected; }
+    cout << "Input: unknown step, empty and bad point lists, bad compose text, a step after roots" << endl;
+    cout << "Actual Output: " << rejected << " rejected" << endl;
+    cout << "Expected Output: 5 rejected" << endl;
+    if (rejected == 5) cout << "Passed: Pipeline step validation." << endl;
+    else cout << "Failed: Pipeline step validation." << endl; });
+
+    // GROUP 21: CPU Dispatch Tests
+    cout << "=== GROUP 21: CPU Dispatch Tests ===" << endl;
+
+    // Test 142: Every supported instruction set gives bit-identical results
+    cout << endl;
+    measureTime("Test 142", []()
+                {
+    vector<double> a(101), b(77), xs(37);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = sin(i * 0.37);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = cos(i * 0.91);
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = -1.0 + i / 18.0;
+    Polynomial pa(a), pb(b);
+    polydispatch::Isa original = polydispatch::isa();
+    vector<double> reference(xs.size()), values(xs.size());
+    Polynomial refProduct, refSum, refDifference;
+    string tried;
+    bool identical = true;
+    for (int i = 0; i < polydispatch::ISA_COUNT; ++i)
+    {
+        polydispatch::Isa isa = static_cast<polydispatch::Isa>(i);
+        if (!polydispatch::setIsa(isa)) continue;
+        tried += string(tried.empty() ? "" : " ") + polydispatch::name(isa);
+        PolynomialView(pa).evaluate(xs.data(), values.data(), xs.size());
+        Polynomial product = pa * pb, sum = pa + pb, difference = pb - pa;
+        if (isa == polydispatch::SCALAR)
+        {
+            reference = values;
+            refProduct = product;
+            refSum = sum;
+            refDifference = difference;
+        }
+        else if (values != reference || !(product == refProduct) || !(sum == refSum) || !(difference == refDifference))
+            identical = false;
+    }
+    polydispatch::setIsa(original);
+    bool scalarMatches = reference[5] == pa.evaluate(xs[5]);
+    cout << "Input: batched evaluate, *, + and - under every instruction set this CPU supports" << endl;
+    cout << "Actual Output: " << tried << " identical " << identical << ", selected " << polydispatch::name(polydispatch::isa()) << endl;
+    cout << "Expected Output: identical 1" << endl;
+    if (identical && scalarMatches && polydispatch::isa() == original) cout << "Passed: CPU dispatch variants agree." << endl;
+    else cout << "Failed: CPU dispatch variants agree." << endl; });
+
+    // GROUP 22: Compensated Evaluation Tests
+    cout << "=== GROUP 22: Compensated Evaluation Tests ===" << endl;
+
+    // Test 143: Compensated Horner recovers a value that plain Horner loses
+    cout << endl;
+    measureTime("Test 143", []()
+                {
+    Polynomial p({1, -8, 28, -56, 70, -56, 28, -8, 1}); // (x - 1)^8
+    double x = 1 + 1.0 / 1024, exact = pow(2.0, -80);
+    double bound = 0;
+    double accurate = p.evaluateAccurate(x, &bound);
+    double plain = p.evaluate(x);
+    cout << "Input: (x - 1)^8 expanded, at x = 1 + 2^-10 (exact value 2^-80)" << endl;
+    cout << "Actual Output: plain " << plain << ", accurate " << accurate << " +- " << bound << endl;
+    cout << "Expected Output: accurate " << exact << " within the bound, bound below 1e-3 relative" << endl;
+    if (fabs(accurate - exact) <= bound && bound < 1e-3 * exact && fabs(plain - exact) > bound) cout << "Passed: Compensated Horner near a root." << endl;
+    else cout << "Failed: Compensated Horner near a root." << endl; });
+
+    // Test 144: Batched form matches the scalar form and its bounds hold
+    cout << endl;
+    measureTime("Test 144", []()
+                {
+    Polynomial p({1, -8, 28, -56, 70, -56, 28, -8, 1}); // (x - 1)^8
+    vector<double> xs, out(19), bounds(19);
+    for (int k = -9; k <= 9; ++k) xs.push_back(1 + k / 4096.0);
+    p.evaluateAccurate(xs.data(), out.data(), xs.size(), bounds.data());
+    bool same = true, within = true;
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        double bound;
+        if (p.evaluateAccurate(xs[i], &bound) != out[i] || bound != bounds[i]) same = false;
+        double exact = pow(xs[i] - 1, 8); // xs[i] - 1 and its powers are exact here
+        if (!(fabs(out[i] - exact) <= bounds[i])) within = false;
+    }
+    cout << "Input: (x - 1)^8 at 19 points 1 + k/4096, batched and one at a time" << endl;
+    cout << "Actual Output: same " << same << ", within bounds " << within << endl;
+    cout << "Expected Output: same 1, within bounds 1" << endl;
+    if (same && within) cout << "Passed: Batched compensated Horner." << endl;
+    else cout << "Failed: Batched compensated Horner." << endl; });
+
+    // GROUP 23: Interval Evaluation Tests
+    cout << "=== GROUP 23: Interval Evaluation Tests ===" << endl;
+
+    // Test 145: Enclosures contain the true range and are tight near a root
+    cout << endl;
+    measureTime("Test 145", []()
+                {
+    Polynomial square({0, 0, 1});                       // x^2
+    Polynomial p({1, -8, 28, -56, 70, -56, 28, -8, 1}); // (x - 1)^8
+    double sLo, sHi, pLo, pHi;
+    square.evaluateInterval(1, 2, sLo, sHi);
+    p.evaluateInterval(0.9, 1.1, pLo, pHi);
+    bool contains = true;
+    for (int i = 0; i <= 1000; ++i)
+    {
+        double x = 0.9 + 0.2 * i / 1000, bound;
+        double y = p.evaluateAccurate(x, &bound);
+        if (y - bound < pLo || y + bound > pHi) contains = false;
+    }
+    cout << "Input: x^2 on [1, 2]; (x - 1)^8 expanded on [0.9, 1.1]" << endl;
+    cout << "Actual Output: [" << sLo << ", " << sHi << "] [" << pLo << ", " << pHi << "]" << endl;
+    cout << "Expected Output: [1, 4] and an enclosure of [0, 1e-08] narrower than 1e-6" << endl;
+    if (sLo <= 1 && sLo > 1 - 1e-12 && sHi >= 4 && sHi < 4 + 1e-12 && contains && pLo <= 0 && pHi >= 1e-8 && pHi - pLo < 1e-6) cout << "Passed: Interval enclosures." << endl;
+    else cout << "Failed: Interval enclosures." << endl; });
+
+    // Test 146: Batched intervals match single calls and prune a root-free box
+    cout << endl;
+    measureTime("Test 146", []()
+                {
+    Polynomial p({-2, 0, 1}); // x^2 - 2
+    vector<double> los, his;
+    for (int i = 0; i < 20; ++i)
+    {
+        los.push_back(-2 + 0.2 * i);
+        his.push_back(-2 + 0.2 * (i + 1));
+    }
+    vector<double> outLo(20), outHi(20);
+    p.evaluateInterval(los.data(), his.data(), outLo.data(), outHi.data(), 20);
+    bool same = true;
+    int kept = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        double lo, hi;
+        p.evaluateInterval(los[i], his[i], lo, hi);
+        if (lo != outLo[i] || hi != outHi[i]) same = false;
+        if (outLo[i] <= 0 && outHi[i] >= 0) ++kept; // May hold a root
+    }
+    cout << "Input: x^2 - 2 over 20 boxes of width 0.2 covering [-2, 2]" << endl;
+    cout << "Actual Output: same " << same << ", boxes kept " << kept << endl;
+    cout << "Expected Output: same 1, boxes kept 2" << endl;
+    if (same && kept == 2) cout << "Passed: Batched interval pruning." << endl;
+    else cout << "Failed: Batched interval pruning." << endl; });
+
+    // GROUP 24: Bernstein Basis Tests
+    cout << "=== GROUP 24: Bernstein Basis Tests ===" << endl;
+
+    // Test 147: Conversion round trip, subdivision and degree elevation
+    cout << endl;
+    measureTime("Test 147", []()
+                {
+    Polynomial p({1, -3, 0.5, 2}); // 2x^3 + 0.5x^2 - 3x + 1
+    BernsteinPolynomial bp(p, -1, 2);
+    Polynomial back = bp.toPolynomial();
+    BernsteinPolynomial left = bp, right;
+    left.subdivide(0.5, right);
+    BernsteinPolynomial elevated = bp;
+    elevated.elevate();
+    elevated.elevate();
+    double maxError = 0;
+    for (double x = -1; x <= 2; x += 0.25)
+    {
+        const BernsteinPolynomial &piece = x <= 0.5 ? left : right;
+        maxError = max({maxError, fabs(bp.evaluate(x) - p.evaluate(x)), fabs(piece.evaluate(x) - p.evaluate(x)),
+                        fabs(elevated.evaluate(x) - p.evaluate(x))});
+    }
+    double lo, hi;
+    bp.bounds(lo, hi);
+    cout << "Input: 2x^3 + 0.5x^2 - 3x + 1 on [-1, 2]; convert back, split at 0.5, elevate twice" << endl;
+    cout << "Actual Output: " << back << ", degree " << elevated.degree() << ", max error " << maxError << ", hull [" << lo << ", " << hi << "]" << endl;
+    cout << "Expected Output: 2x^3 + 0.5x^2 - 3x + 1, degree 5, max error < 1e-12, hull containing [-0.19, 13]" << endl;
+    if (back.equals(p, 1e-12) && elevated.degree() == 5 && maxError < 1e-12 && lo <= -0.19 && hi >= 13) cout << "Passed: Bernstein conversion and subdivision." << endl;
+    else cout << "Failed: Bernstein conversion and subdivision." << endl; });
+
+    // Test 148: Bezier clipping finds every root in the interval
+    cout << endl;
+    measureTime("Test 148", []()
+                {
+    // (x - 0.1)(x - 0.35)(x - 0.6)(x - 0.85)(x - 3): four roots inside [0, 1], one outside
+    Polynomial p({1});
+    for (double r : {0.1, 0.35, 0.6, 0.85, 3.0}) p = p * Polynomial({-r, 1});
+    vector<double> roots = BernsteinPolynomial(p, 0, 1).roots(1e-12);
+    bool ok = roots.size() == 4;
+    double expected[4] = {0.1, 0.35, 0.6, 0.85};
+    for (size_t i = 0; ok && i < 4; ++i)
+        if (fabs(roots[i] - expected[i]) > 1e-10) ok = false;
+    cout << "Input: roots 0.1, 0.35, 0.6, 0.85 and 3 of a quintic, searched on [0, 1]" << endl;
+    cout << "Actual Output:";
+    for (double r : roots) cout << " " << r;
+    cout << endl;
+    cout << "Expected Output: 0.1 0.35 0.6 0.85" << endl;
+    if (ok) cout << "Passed: Bezier clipping roots." << endl;
+    else cout << "Failed: Bezier clipping roots." << endl; });
+
+    // Test 149: Tangent (double) roots are found once; a positive minimum is not a root
+    cout << endl;
+    measureTime("Test 149", []()
+                {
+    vector<double> square = BernsteinPolynomial(Polynomial({0.25, -1, 1})).roots();                   // (x - 0.5)^2
+    vector<double> mixed = BernsteinPolynomial(Polynomial({0.09, -0.6, 1}) * Polynomial({-0.7, 1})).roots(); // (x - 0.3)^2 (x - 0.7)
+    vector<double> none = BernsteinPolynomial(Polynomial({0.251, -1, 1})).roots();                    // (x - 0.5)^2 + 0.001
+    cout << "Input: (x - 0.5)^2, (x - 0.3)^2 (x - 0.7) and (x - 0.5)^2 + 0.001 on [0, 1]" << endl;
+    cout << "Actual Output:";
+    for (double r : square) cout << " " << r;
+    cout << ";";
+    for (double r : mixed) cout << " " << r;
+    cout << "; " << none.size() << " roots" << endl;
+    cout << "Expected Output: 0.5; 0.3 0.7; 0 roots" << endl;
+    if (square.size() == 1 && fabs(square[0] - 0.5) < 1e-9 && mixed.size() == 2 && fabs(mixed[0] - 0.3) < 1e-9 &&
+        fabs(mixed[1] - 0.7) < 1e-9 && none.empty())
+        cout << "Passed: Bezier clipping tangent roots." << endl;
+    else cout << "Failed: Bezier clipping tangent roots." << endl; });
+
+    // GROUP 25: Rational Function Tests
+    cout << "=== GROUP 25: Rational Function Tests ===" << endl;
+
+    // Test 150: Common factors cancel and evaluation matches the two-pass quotient
+    cout << endl;
+    measureTime("Test 150", []()
+                {
+    // (x - 1)(x + 2) / ((x - 1)(x^2 + 1)) reduces to (x + 2) / (x^2 + 1)
+    Polynomial n = Polynomial({-1, 1}) * Polynomial({2, 1});
+    Polynomial d = Polynomial({-1, 1}) * Polynomial({1, 0, 1});
+    RationalFunction r(n, d);
+    RationalFunction sum = r + RationalFunction(Polynomial({1}), Polynomial({1, 0, 1}));
+    RationalFunction dr = r.derivative();
+    vector<double> xs(37), out(37);
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = -3 + 0.17 * i;
+    r.evaluate(xs.data(), out.data(), xs.size());
+    double maxError = 0;
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        double x = xs[i];
+        double expected = (x + 2) / (x * x + 1);
+        double expectedDerivative = (1 - 4 * x - x * x) / ((x * x + 1) * (x * x + 1));
+        maxError = max({maxError, fabs(out[i] - expected), fabs(r.evaluate(x) - expected),
+                        fabs(dr.evaluate(x) - expectedDerivative), fabs(sum.evaluate(x) - (x + 3) / (x * x + 1))});
+    }
+    cout << "Input: (x - 1)(x + 2) / ((x - 1)(x^2 + 1)), its derivative and the sum with 1 / (x^2 + 1)" << endl;
+    cout << "Actual Output: " << r << ", derivative denominator degree " << dr.denominator().degree() << ", max error " << maxError << endl;
+    cout << "Expected Output: (1x + 2) / (1x^2 + 1), derivative denominator degree 4, max error < 1e-12" << endl;
+    if (r.denominator().equals(Polynomial({1, 0, 1}), 1e-12) && r.numerator().equals(Polynomial({2, 1}), 1e-12) &&
+        dr.denominator().degree() == 4 && sum.denominator().degree() == 2 && maxError < 1e-12)
+        cout << "Passed: Rational reduction and evaluation." << endl;
+    else cout << "Failed: Rational reduction and evaluation." << endl; });
+
+    // Test 151: Partial fractions integrate repeated and complex poles
+    cout << endl;
+    measureTime("Test 151", []()
+                {
+    // (x^4 + 1) / ((x + 1)^2 (x^2 + 1)) = 1 - 1/(x + 1) + 1/(x + 1)^2 - x/(x^2 + 1)
+    Polynomial d = Polynomial({1, 1}) * Polynomial({1, 1}) * Polynomial({1, 0, 1});
+    RationalFunction r(Polynomial({1, 0, 0, 0, 1}), d);
+    RationalFunction::PartialFractions pf = r.partialFractions();
+    double maxError = 0;
+    for (double x = 0; x <= 3; x += 0.25) maxError = max(maxError, fabs(pf.evaluate(x) - r.evaluate(x)));
+    double actual = r.integral(0, 1);
+    double expected = 1.5 - 1.5 * log(2.0);
+    bool threw = false;
+    try { r.integral(-2, 0); } catch (const domain_error &) { threw = true; }
+    cout << "Input: (x^4 + 1) / ((x + 1)^2 (x^2 + 1)) integrated over [0, 1] and over [-2, 0]" << endl;
+    cout << "Actual Output: " << pf.linear.size() << " linear and " << pf.quadratic.size() << " quadratic terms, integral " << actual
+         << ", pole " << (threw ? "rejected" : "accepted") << endl;
+    cout << "Expected Output: 2 linear and 1 quadratic terms, integral " << expected << ", pole rejected" << endl;
+    if (pf.linear.size() == 2 && pf.quadratic.size() == 1 && maxError < 1e-10 && fabs(actual - expected) < 1e-10 && threw)
+        cout << "Passed: Partial fraction integration." << endl;
+    else cout << "Failed: Partial fraction integration." << endl; });
+
+    // Test 152: Nearly common factors are kept unless approximate cancellation is requested
+    cout << endl;
+    measureTime("Test 152", []()
+                {
+    RationalFunction r(Polynomial({0, 1}), Polynomial({1e-10, 0, 1}));   // x / (x^2 + 1e-10)
+    RationalFunction s(Polynomial({1e-12, 1}), Polynomial({0, 1}));      // (x + 1e-12) / x
+    RationalFunction loose(Polynomial({1e-12, 1}), Polynomial({0, 1}), 1e-9);
+    RationalFunction zero = RationalFunction() * RationalFunction();
+    double atSmall = r.evaluate(1e-5), atZero = r.evaluate(0);
+    cout << "Input: x / (x^2 + 1e-10) at 1e-5 and 0; (x + 1e-12) / x exactly and with tolerance 1e-9; 0 * 0" << endl;
+    cout << "Actual Output: " << atSmall << ", " << atZero << "; degrees " << s.numerator().degree() << "/" << s.denominator().degree()
+         << " and " << loose.numerator().degree() << "/" << loose.denominator().degree() << "; " << zero.evaluate(2) << endl;
+    cout << "Expected Output: 50000, 0; degrees 1/1 and 0/0; 0" << endl;
+    if (fabs(atSmall - 50000) < 1e-6 && atZero == 0 && s.numerator().degree() == 1 && s.denominator().degree() == 1 &&
+        loose.denominator().degree() == 0 && zero.evaluate(2) == 0)
+        cout << "Passed: Exact factor cancellation." << endl;
+    else cout << "Failed: Exact factor cancellation." << endl; });
+
+    // GROUP 26: Multivariate Polynomial Tests
+    cout << "=== GROUP 26: Multivariate Polynomial Tests ===" << endl;
+
+    // Test 153: Product, partial derivative and substitution in three variables
+    cout << endl;
+    measureTime("Test 153", []()
+                {
+    MultivariatePolynomial x = MultivariatePolynomial::variable(3, 0);
+    MultivariatePolynomial y = MultivariatePolynomial::variable(3, 1);
+    MultivariatePolynomial z = MultivariatePolynomial::variable(3, 2);
+    MultivariatePolynomial one = MultivariatePolynomial::constant(3, 1);
+    MultivariatePolynomial p = (x + y) * (x - y);         // x^2 - y^2
+    MultivariatePolynomial q = p * (z + one);             // x^2 z + x^2 - y^2 z - y^2
+    MultivariatePolynomial dq = q.derivative(1);          // -2yz - 2y
+    MultivariatePolynomial s = q.substitute(2, Polynomial({0, 0, 1}), 0); // z -> x^2
+    MultivariatePolynomial expected(3, {{{4, 0, 0}, 1}, {{2, 0, 0}, 1}, {{2, 2, 0}, -1}, {{0, 2, 0}, -1}});
+    cout << "Input: q = (x0 + x1)(x0 - x1)(x2 + 1), dq/dx1, and x2 replaced by x0^2" << endl;
+    cout << "Actual Output: q = " << q << "; dq/dx1 = " << dq << "; substituted = " << s << endl;
+    cout << "Expected Output: q with 4 terms; dq/dx1 = -2x1*x2 - 2x1; substituted = " << expected << endl;
+    if (q.terms() == 4 && q.coefficient({2, 0, 1}) == 1 && q.coefficient({0, 2, 0}) == -1 && dq.terms() == 2 &&
+        dq.coefficient({0, 1, 1}) == -2 && dq.coefficient({0, 1, 0}) == -2 && s == expected && q.degree() == 3)
+        cout << "Passed: Multivariate arithmetic." << endl;
+    else cout << "Failed: Multivariate arithmetic." << endl; });
+
+    // Test 154: Parallel product and compiled plan agree with term-by-term evaluation
+    cout << endl;
+    measureTime("Test 154", []()
+                {
+    // Dense (1 + x0 + ... + x4)^6 squared: 462 terms times itself, split into chunks
+    MultivariatePolynomial base = MultivariatePolynomial::constant(5, 1);
+    for (int v = 0; v < 5; ++v) base = base + MultivariatePolynomial::variable(5, v);
+    MultivariatePolynomial p = MultivariatePolynomial::constant(5, 1);
+    for (int i = 0; i < 6; ++i) p = p * base;
+    size_t savedGrain = polytasks::grainSize();
+    unsigned savedWorkers = polytasks::workerCount();
+    polytasks::setGrainSize(1 << 10);
+    polytasks::setWorkerCount(4);
+    MultivariatePolynomial square = p * p;
+    polytasks::setWorkerCount(savedWorkers);
+    polytasks::setGrainSize(savedGrain);
+    MultivariatePolynomial::Plan plan = square.plan();
+    vector<double> points;
+    for (int i = 0; i < 40; ++i)
+        for (int v = 0; v < 5; ++v) points.push_back(0.1 * ((i * 7 + v * 3) % 11) - 0.5);
+    vector<double> out(40);
+    plan.evaluate(points.data(), out.data(), 40);
+    double maxError = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        const double *pt = points.data() + 5 * i;
+        double sum = 1 + pt[0] + pt[1] + pt[2] + pt[3] + pt[4];
+        double exact = pow(sum, 12);
+        maxError = max({maxError, fabs(out[i] - exact) / max(1.0, fabs(exact)),
+                        fabs(square.evaluate(pt) - exact) / max(1.0, fabs(exact))});
+    }
+    cout << "Input: (1 + x0 + x1 + x2 + x3 + x4)^6 squared, evaluated at 40 points" << endl;
+    cout << "Actual Output: " << p.terms() << " and " << square.terms() << " terms, coefficient of x0^12 " << square.coefficient({12, 0, 0, 0, 0})
+         << ", max relative error " << maxError << endl;
+    cout << "Expected Output: 462 and 6188 terms, coefficient of x0^12 1, max relative error < 1e-10" << endl;
+    if (p.terms() == 462 && square.terms() == 6188 && square.coefficient({12, 0, 0, 0, 0}) == 1 &&
+        square.coefficient({2, 2, 2, 2, 4}) == 479001600.0 / 16 / 24 && maxError < 1e-10)
+        cout << "Passed: Multivariate product and plan." << endl;
+    else cout << "Failed: Multivariate product and plan." << endl; });
+
+    // Test 155: Scalars must go through constant(), not an int conversion
+    cout << endl;
+    measureTime("Test 155", []()
+                {
+    bool converts = is_convertible<int, MultivariatePolynomial>::value;
+    MultivariatePolynomial x = MultivariatePolynomial::variable(2, 0);
+    MultivariatePolynomial doubled = x * MultivariatePolynomial::constant(2, 2);
+    MultivariatePolynomial zero;
+    double point[2] = {3, 5};
+    cout << "Input: is int convertible to MultivariatePolynomial; x0 * constant(2, 2) at (3, 5); default" << endl;
+    cout << "Actual Output: " << (converts ? "convertible" : "not convertible") << ", " << doubled.evaluate(point)
+         << ", " << zero.variables() << " variable, " << zero.terms() << " terms" << endl;
+    cout << "Expected Output: not convertible, 6, 1 variable, 0 terms" << endl;
+    if (!converts && doubled.evaluate(point) == 6 && zero.variables() == 1 && zero.terms() == 0) cout << "Passed: No implicit scalar conversion." << endl;
+    else cout << "Failed: No implicit scalar conversion." << endl; });
+
+    // GROUP 27: Polynomial Fitter Tests
+    cout << "=== GROUP 27: Polynomial Fitter Tests ===" << endl;
+
+    // Test 156: Fitters filled on separate threads merge into the exact cubic
+    cout << endl;
+    measureTime("Test 156", []()
+                {
+    Polynomial p({1, -2, 0.5, 0.25});
+    vector<PolynomialFitter> fitters(4, PolynomialFitter(5, 0, 10));
+    vector<thread> threads;
+    for (int w = 0; w < 4; ++w)
+        threads.emplace_back([&, w]()
+                             {
+            for (int i = w; i < 200000; i += 4)
+            {
+                double x = 10.0 * i / 200000;
+                fitters[w].add(x, p.evaluate(x));
+            } });
+    for (thread &t : threads) t.join();
+    for (int w = 1; w < 4; ++w) fitters[0].merge(fitters[w]);
+    Polynomial cubic = fitters[0].fit(3), quintic = fitters[0].fit(5);
+    cout << "Input: 200000 samples of 0.25x^3 + 0.5x^2 - 2x + 1 on [0, 10] over 4 merged fitters" << endl;
+    cout << "Actual Output: " << fitters[0].count() << " samples, cubic " << cubic << ", residuals " << fitters[0].residual(3) << " / " << fitters[0].residual(1) << endl;
+    cout << "Expected Output: 200000 samples, cubic 0.25x^3 + 0.5x^2 - 2x + 1, residual ~0 for degree 3 and large for degree 1" << endl;
+    if (fitters[0].count() == 200000 && cubic.equals(p, 1e-9) && quintic.equals(p, 1e-8) &&
+        fitters[0].residual(3) < 1e-12 && fitters[0].residual(1) > 1)
+        cout << "Passed: Merged streaming fit." << endl;
+    else cout << "Failed: Merged streaming fit." << endl; });
+
+    // Test 157: A lower degree from the same stream is the ordinary least-squares fit
+    cout << endl;
+    measureTime("Test 157", []()
+                {
+    // Least-squares line through y = x^2 on the points -1, 0, 1, 2 is y = x + 1
+    PolynomialFitter fitter(4, -1, 2);
+    vector<double> xs = {-1, 0, 1, 2}, ys = {1, 0, 1, 4};
+    fitter.add(xs.data(), ys.data(), xs.size());
+    Polynomial line = fitter.fit(1);
+    bool threw = false;
+    try { fitter.fit(4); } catch (const runtime_error &) { threw = true; }
+    cout << "Input: y = x^2 at -1, 0, 1, 2; fit degree 1, then degree 4" << endl;
+    cout << "Actual Output: " << line << ", residual " << fitter.residual(1) << ", degree 4 " << (threw ? "rejected" : "accepted") << endl;
+    cout << "Expected Output: 1x + 1, residual 4, degree 4 rejected" << endl;
+    if (line.equals(Polynomial({1, 1}), 1e-12) && fabs(fitter.residual(1) - 4) < 1e-12 && threw)
+        cout << "Passed: Least-squares fit of lower degree." << endl;
+    else cout << "Failed: Least-squares fit of lower degree." << endl; });
 }
 
 int main()
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <csignal>
+#include <stdexcept>
+#include "../polynomial.h"
+#include "../polynomial_catalog.h"
+#include "../polynomial_service.h"
+
+using namespace std;
+
+// Evaluation daemon: serves every polynomial of a catalog on a Unix domain
+// socket until SIGINT or SIGTERM. Polynomial i of the catalog is index i in
+// the protocol (see polynomial_service.h).
+//
+// Usage: polyd CATALOG SOCKET [--window-us N] [--max-batch N]
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        cerr << "Usage: polyd CATALOG SOCKET [--window-us N] [--max-batch N]" << endl;
+        return 1;
+    }
+
+    PolynomialServiceOptions options;
+    vector<Polynomial> polynomials;
+    try
+    {
+        for (int i = 3; i < argc; ++i)
+        {
+            string arg = argv[i];
+            if (i + 1 >= argc)
+                throw invalid_argument("Missing value for " + arg);
+            string value = argv[++i];
+            if (arg == "--window-us")
+                options.windowMicros = stoul(value);
+            else if (arg == "--max-batch")
+                options.maxBatch = stoul(value);
+            else
+                throw invalid_argument("Unknown option " + arg);
+        }
+
+        PolynomialCatalog catalog(argv[1]);
+        for (size_t i = 0; i < catalog.size(); ++i)
+        {
+            polynomials.push_back(catalog[i].toPolynomial());
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    // Handle the shutdown signals synchronously on this thread
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+        PolynomialServer server(polynomials, argv[2], options);
+        thread serving(&PolynomialServer::run, &server);
+        cerr << "Serving " << polynomials.size() << " polynomials on " << argv[2] << endl;
+
+        int received;
+        sigwait(&signals, &received);
+        server.stop();
+        serving.join();
+        cerr << server.requestCount() << " requests in " << server.batchCount() << " batches" << endl;
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
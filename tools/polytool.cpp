@@ -0,0 +1,202 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "../polynomial.h"
+#include "../polynomial_catalog.h"
+#include "../polynomial_parser.h"
+#include "../polynomial_pipeline.h"
+#include "../polynomial_tasks.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Batch driver: applies a pipeline of steps (see polynomial_pipeline.h) to
+// every polynomial of a text file (one per line, as read by
+// PolynomialParser) or a binary catalog, writing one output line per input
+// in input order. Input is processed in chunks of --chunk polynomials spread
+// over the task pool, so memory stays bounded by the chunk size. Throughput
+// is reported on stderr at the end.
+//
+// Usage: polytool [--input FILE] [--output FILE] [--threads N] [--chunk N] STEP...
+//   STEP: derivative | integral | compose=TEXT | evaluate@X,... | roots[@G,...]
+// The input defaults to stdin (text only); a catalog is recognized by its magic.
+
+struct Options
+{
+    string input;
+    string output;
+    unsigned threads = 0;
+    size_t chunk = 1 << 16;
+    PolynomialPipeline pipeline;
+};
+
+static Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg.rfind("--", 0) != 0)
+        {
+            options.pipeline.add(arg);
+            continue;
+        }
+        if (i + 1 >= argc)
+            throw invalid_argument("Missing value for " + arg);
+        string value = argv[++i];
+        if (arg == "--input")
+            options.input = value;
+        else if (arg == "--output")
+            options.output = value;
+        else if (arg == "--threads")
+            options.threads = stoul(value);
+        else if (arg == "--chunk")
+            options.chunk = max<size_t>(1, stoul(value));
+        else
+            throw invalid_argument("Unknown option " + arg);
+    }
+    if (options.pipeline.size() == 0)
+        throw invalid_argument("No steps given.");
+    return options;
+}
+
+static bool isCatalog(const string &path)
+{
+    char magic[8] = {};
+    ifstream in(path, ios::binary);
+    in.read(magic, sizeof(magic));
+    return in.gcount() == sizeof(magic) && memcmp(magic, "POLYCAT", 8) == 0;
+}
+
+// Run fill(i, out) for i in [0, n) across the pool and write the outputs in order
+template <typename Fill>
+static size_t processChunk(size_t n, Fill fill, vector<string> &outputs, ostream &out)
+{
+    const size_t GRAIN = 256;
+    outputs.resize(n);
+    vector<char> ok(n);
+    {
+        polytasks::TaskGroup group;
+        for (size_t lo = 0; lo < n; lo += GRAIN)
+        {
+            group.spawn([&, lo]()
+                        {
+                for (size_t i = lo; i < min(n, lo + GRAIN); ++i)
+                {
+                    outputs[i].clear();
+                    ok[i] = fill(i, outputs[i]);
+                } });
+        }
+        group.sync();
+    }
+
+    size_t failures = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        out << outputs[i];
+        failures += !ok[i];
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        cerr << "Usage: polytool [--input FILE] [--output FILE] [--threads N] [--chunk N] STEP..." << endl;
+        return 1;
+    }
+    if (options.threads > 0)
+        polytasks::setWorkerCount(options.threads);
+
+    ofstream file;
+    if (!options.output.empty())
+    {
+        file.open(options.output);
+        if (!file)
+        {
+            cerr << "Cannot open " << options.output << "." << endl;
+            return 1;
+        }
+    }
+    ostream &out = options.output.empty() ? cout : file;
+
+    auto start = steady_clock::now();
+    size_t total = 0, failures = 0;
+    vector<string> outputs;
+    try
+    {
+        if (!options.input.empty() && isCatalog(options.input))
+        {
+            PolynomialCatalog catalog(options.input);
+            for (size_t base = 0; base < catalog.size(); base += options.chunk)
+            {
+                size_t n = min(options.chunk, catalog.size() - base);
+                failures += processChunk(n, [&](size_t i, string &line)
+                                         { return options.pipeline.apply(catalog[base + i].toPolynomial(), line); },
+                                         outputs, out);
+                total += n;
+            }
+        }
+        else
+        {
+            ifstream inputFile;
+            if (!options.input.empty())
+            {
+                inputFile.open(options.input);
+                if (!inputFile)
+                    throw runtime_error("Cannot open " + options.input + ".");
+            }
+            istream &in = options.input.empty() ? cin : inputFile;
+            vector<string> lines(options.chunk);
+            while (in)
+            {
+                size_t n = 0;
+                while (n < options.chunk && getline(in, lines[n]))
+                    ++n;
+                if (n == 0)
+                    break;
+                failures += processChunk(n, [&](size_t i, string &line)
+                                         {
+                    vector<double> coeffs;
+                    string error;
+                    if (!PolynomialParser::parse(lines[i], coeffs, &error))
+                    {
+                        line = "error: " + error + "\n";
+                        return false;
+                    }
+                    return options.pipeline.apply(Polynomial(coeffs), line); },
+                                         outputs, out);
+                total += n;
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    out.flush();
+    if (!out)
+    {
+        cerr << "Cannot write " << (options.output.empty() ? "standard output" : options.output) << "." << endl;
+        return 1;
+    }
+
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    cerr << total << " polynomials, " << failures << " failed, " << seconds << " s, "
+         << (seconds > 0 ? total / seconds : 0) << " polynomials/s on "
+         << polytasks::workerCount() << " threads" << endl;
+    return failures == 0 ? 0 : 2;
+}